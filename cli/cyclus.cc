@@ -247,6 +247,11 @@ int ParseCliArgs(ArgInfo* ai, int argc, char* argv[]) {
       ("nthreads,j", po::value<int>(), "number of threads to use (if compiled with parallel support)")       
       ("restart", po::value<std::string>(),
        "restart from the specified simulation snapshot [db-file]:[sim-id]:[timestep]")
+      ("py-event-interval", po::value<unsigned int>(),
+       "run the Python event loop every N time steps, 0 only while a server "
+       "is attached, defaults to 1")
+      ("py-batch",
+       "tick and tock all Python agents with one call into Python per phase")
       ;
 
   po::options_description verbosity("Output Verbosity");
@@ -259,6 +264,10 @@ int ParseCliArgs(ArgInfo* ai, int argc, char* argv[]) {
        "number of warnings to issue per kind, defaults to 42")
       ("warn-as-error", "throw errors when warnings are issued")
       ("rng-print", "prints the full relaxng schema for the simulation")
+      ("profile", "record wall times per phase and agent to the Profile "
+       "table and per exchange to the ExchangeProfile table")
+      ("profile-trace", po::value<std::string>(),
+       "also write every profiled call to a Chrome trace event file")
       ;
 
   po::options_description file_options("File Options");
@@ -605,6 +614,22 @@ void GetSimInfo(ArgInfo* ai) {
   if (ai->vm.count("warn-as-error"))
     cyclus::warn_as_error = true;
 
+  // Profiling params
+  if (ai->vm.count("profile") || ai->vm.count("profile-trace")) {
+    Profiler::On() = true;
+  }
+  if (ai->vm.count("profile-trace")) {
+    Profiler::TraceFile() = ai->vm["profile-trace"].as<std::string>();
+  }
+
+  // Python params
+  if (ai->vm.count("py-event-interval")) {
+    PY_EVENT_LOOP_INTERVAL = ai->vm["py-event-interval"].as<unsigned int>();
+  }
+  if (ai->vm.count("py-batch")) {
+    PY_BATCH_DISPATCH = true;
+  }
+
   // Output path
   ai->output_path = "cyclus.sqlite";
   if (ai->vm.count("output-path")) {
@@ -1949,9 +1949,7 @@ class SnapshotInvFilter(CodeGeneratorFilter):
         return impl
 
     res_impl = {
-        CYCNS + '::toolkit::ResBuf': (
-            'invs[\"{var}\"] = {var}.PopNRes({var}.count());\n'
-            '{var}.Push(invs["{var}"]);\n'),
+        CYCNS + '::toolkit::ResBuf': "invs[\"{var}\"] = {var}.ResValues();\n",
         CYCNS + '::toolkit::ResMap': "invs[\"{var}\"] = {var}.ResValues();\n",
         CYCNS + '::toolkit::TotalInvTracker': ';\n',
         }
@@ -272,6 +272,13 @@ cdef extern from "error.h" namespace "cyclus":
     cdef cpp_bool warn_as_error
 
 
+cdef extern from "pyhooks.h" namespace "cyclus":
+
+    cdef int PY_EVENT_LOOP_INTERVAL
+    cdef cpp_bool PY_EVENT_LOOP_ATTACHED
+    cdef cpp_bool PY_BATCH_DISPATCH
+
+
 cdef extern from "pyhooks.h" namespace "cyclus::toolkit":
 
     cdef std_string PyToJson(std_string) except +
@@ -673,8 +680,8 @@ cdef extern from "agent.h" namespace "cyclus":
 cdef extern from "time_listener.h" namespace "cyclus":
 
     cdef cppclass TimeListener(Ider):
-        void Tick()
-        void Tock()
+        void Tick() except *
+        void Tock() except *
         void Decision()
         cpp_bool IsShim()
 
@@ -787,6 +794,8 @@ cdef extern from "context.h" namespace "cyclus":
         shared_ptr[Composition] GetRecipe(std_string)
         void SchedBuild(Agent*, std_string)
         void SchedBuild(Agent*, std_string, int)
+        void SchedBuilds(Agent*, std_string, int) except +
+        void SchedBuilds(Agent*, std_string, int, int) except +
         void SchedDecom(Agent*)
         void SchedDecom(Agent*, int)
         void AddRecipe(std_string, shared_ptr[Composition])
@@ -5,6 +5,7 @@ import time
 import json
 from functools import wraps
 
+import cyclus.lib
 import cyclus.system
 from cyclus.system import asyncio
 
@@ -12,6 +13,13 @@ from cyclus.system import asyncio
 STATE = None
 
 
+def attach(state):
+    """Attaches a SimState to the event loop, or detaches it with None."""
+    global STATE
+    STATE = state
+    cyclus.lib.set_event_loop_attached(state is not None)
+
+
 def loop():
     """Adds tasks to the queue"""
     if STATE is None:
@@ -20,6 +20,7 @@ ctypedef cpp_cyclus.Agent* agent_ptr
 ctypedef cpp_cyclus.Region* region_ptr
 ctypedef cpp_cyclus.Institution* institution_ptr
 ctypedef cpp_cyclus.Facility* facility_ptr
+ctypedef cpp_cyclus.TimeListener* time_listener_ptr
 cdef cpp_cyclus.Agent* dynamic_agent_ptr(object)
 
 cdef class _Datum:
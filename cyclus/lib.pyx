@@ -797,6 +797,40 @@ def set_warn_as_error(bint wae):
     """Sets whether warnings should be treated as errors."""
     cpp_cyclus.warn_as_error = wae
 
+#
+# Python dispatch
+#
+def get_event_loop_interval():
+    """Returns the number of time steps between runs of the event loop."""
+    return cpp_cyclus.PY_EVENT_LOOP_INTERVAL
+
+
+def set_event_loop_interval(int n):
+    """Sets the number of time steps between runs of the event loop. With 0,
+    the event loop only runs while a simulation state is attached to it (see
+    cyclus.events.attach).
+    """
+    if n < 0:
+        raise ValueError("the event loop interval must be non-negative")
+    cpp_cyclus.PY_EVENT_LOOP_INTERVAL = n
+
+
+def set_event_loop_attached(bint attached):
+    """Sets whether a simulation state is attached to the event loop."""
+    cpp_cyclus.PY_EVENT_LOOP_ATTACHED = attached
+
+
+def get_batch_dispatch():
+    """Returns whether all Python agents are ticked and tocked at once."""
+    return bool_to_py(cpp_cyclus.PY_BATCH_DISPATCH)
+
+
+def set_batch_dispatch(bint batch):
+    """Sets whether all Python agents are ticked and tocked with a single call
+    into Python per phase, rather than with one call per agent.
+    """
+    cpp_cyclus.PY_BATCH_DISPATCH = batch
+
 #
 # XML
 #
@@ -1651,6 +1685,14 @@ cdef class _Context:
         self.ptx.SchedBuild(dynamic_agent_ptr(parent),
                             str_py_to_cpp(proto_name), t)
 
+    def schedule_builds(self, parent, proto_name, int n, int t=-1):
+        """Schedules n agents of the named prototype to be built for the
+        specified parent at timestep t. This is much faster than calling
+        schedule_build n times when deploying large fleets of identical agents.
+        """
+        self.ptx.SchedBuilds(dynamic_agent_ptr(parent),
+                             str_py_to_cpp(proto_name), n, t)
+
     def schedule_decom(self, agent, int t=-1):
         """Schedules the given Agent to be decommissioned at the specified timestep
         t. The default t=-1 results in the decommission being scheduled for the
@@ -1934,6 +1976,33 @@ cpdef void _del_agent(int i):
     if i in _AGENT_REFS:
         del _AGENT_REFS[i]
 
+
+cpdef list call_agents(object method, object ids):
+    """Calls a phase ('tick' or 'tock') of the Python agents with the given ids,
+    in order. This is how the timer dispatches phases to all Python agents at
+    once. The phase goes through the agent's C++ shim, so that the logic of the
+    C++ base class (e.g., institutions decommissioning their children on tock)
+    runs just as with one call per agent. Returns the ids of the agents that
+    are not Python agents. Users should never need to call this.
+    """
+    cdef list rest = []
+    cdef cpp_cyclus.TimeListener* tl
+    if method not in ('tick', 'tock'):
+        raise ValueError("unknown phase " + repr(method))
+    for i in ids:
+        a = _AGENT_REFS.get(i)
+        if getattr(a, method, None) is None:
+            rest.append(i)
+            continue
+        tl = dynamic_cast[time_listener_ptr](dynamic_agent_ptr(a))
+        if tl == NULL:
+            rest.append(i)
+        elif method == 'tick':
+            tl.Tick()
+        else:
+            tl.Tock()
+    return rest
+
 #
 # Functions to allow for time series facilities to interaction with the timeseries
 # callbacks.
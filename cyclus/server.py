@@ -382,10 +382,9 @@ def main(args=None):
     """Main cyclus server entry point."""
     p = make_parser()
     ns = p.parse_args(args=args)
-    cyclus.events.STATE = state = SimState(input_file=ns.input_file,
-                                           output_path=ns.output_path,
-                                           memory_backend=True,
-                                           debug=ns.debug)
+    state = SimState(input_file=ns.input_file, output_path=ns.output_path,
+                     memory_backend=True, debug=ns.debug)
+    cyclus.events.attach(state)
     # load initial and repeating actions
     for kind, params in ns.initial_actions:
         if kind in EVENT_ACTIONS:
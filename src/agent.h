@@ -246,12 +246,8 @@ class Agent : public StateWrangler, virtual public Ider, public EconomicEntity {
   ///
   ///   cyclus::Inventories SnapshotInv() {
   ///     cyclus::Inventories invs;
-  ///     cyclus::toolkit::ResVec rs = buf1.PopNRes(buf1.count());
-  ///     buf1.Push(rs); // Snapshot must not change agent's state
-  ///     invs["buf1"] = rs;
-  ///     rs = buf2.PopNRes(buf2.count());
-  ///     buf2.Push(rs); // Snapshot must not change agent's state
-  ///     invs["buf2"] = rs;
+  ///     invs["buf1"] = buf1.ResValues();
+  ///     invs["buf2"] = buf2.ResValues();
   ///
   ///     // ...
   ///
@@ -269,6 +265,20 @@ class Agent : public StateWrangler, virtual public Ider, public EconomicEntity {
   /// @warning This function MUST NOT modify the agent's internal state.
   virtual Inventories SnapshotInv() = 0;
 
+  /// Returns a number that increases whenever any of the inventories returned
+  /// by SnapshotInv may have changed, or a negative number (the default) if
+  /// the agent does not track changes. Explicit inventories (see
+  /// SimInfo::explicit_inventory) are only re-aggregated from SnapshotInv
+  /// when this number changes. For agents whose inventories are all ResBufs
+  /// or ResMaps, the sum of their versions is such a number:
+  ///
+  /// @code
+  /// virtual int InventoryVersion() {
+  ///   return buf1.version() + buf2.version();
+  /// }
+  /// @endcode
+  virtual int InventoryVersion() { return -1; }
+
   /// recursively prints the parent-child tree
   std::string PrintChildren();
 
@@ -322,11 +332,17 @@ class Agent : public StateWrangler, virtual public Ider, public EconomicEntity {
   /// END of their Decommission function.
   virtual void Decommission();
 
-  /// default implementation for material preferences.
-  virtual void AdjustMatlPrefs(PrefMap<Material>::type& prefs) {}
+  /// default implementation for material preferences. Agent types that keep
+  /// it are not asked to adjust preferences again, so overrides should not
+  /// call it.
+  virtual void AdjustMatlPrefs(PrefMap<Material>::type& prefs) {
+    DefaultPrefs::Reached();
+  }
 
-  /// default implementation for material preferences.
-  virtual void AdjustProductPrefs(PrefMap<Product>::type& prefs) {}
+  /// default implementation for product preferences, see AdjustMatlPrefs.
+  virtual void AdjustProductPrefs(PrefMap<Product>::type& prefs) {
+    DefaultPrefs::Reached();
+  }
 
   /// Returns an agent's xml rng schema for initializing from input files. All
   /// concrete agents should override this function. This must validate the same
@@ -5,20 +5,23 @@
 #include <boost/weak_ptr.hpp>
 #include <limits>
 
-#include "request.h"
 #include "package.h"
+#include "pool_base.h"
+#include "request.h"
 
 namespace cyclus {
 
 class Trader;
 template <class T> class BidPortfolio;
+template <class T> struct ExchangeContext;
 
 /// @class Bid
 ///
 /// @brief A Bid encapsulates all the information required to communicate a bid
 /// response to a request for a resource, including the resource bid and the
-/// bidder.
-template <class T> class Bid {
+/// bidder. Bids are allocated from a pool, as every exchange creates and
+/// destroys them in large numbers.
+template <class T> class Bid : public PoolBase<Bid<T>> {
  public:
   /// @brief a factory method for a bid
   /// @param request the request being responded to by this bid
@@ -92,7 +95,13 @@ template <class T> class Bid {
   /// @return the preference of this bid
   inline double preference() const { return preference_; }
 
+  /// @return the position of this bid in the exchange it was last added to
+  /// (see ExchangeContext::AddBid), -1 if it has not been added to any
+  inline int ordinal() const { return ordinal_; }
+
  private:
+  friend struct ExchangeContext<T>;
+
   /// @brief constructors are private to require use of factory methods
   Bid(Request<T>* request, boost::shared_ptr<T> offer, Trader* bidder,
       bool exclusive, double preference,
@@ -102,7 +111,8 @@ template <class T> class Bid {
         bidder_(bidder),
         exclusive_(exclusive),
         preference_(preference),
-        package_(package) {}
+        package_(package),
+        ordinal_(-1) {}
   /// @brief constructors are private to require use of factory methods
   Bid(Request<T>* request, boost::shared_ptr<T> offer, Trader* bidder,
       bool exclusive = false, Package::Ptr package = Package::unpackaged())
@@ -111,7 +121,8 @@ template <class T> class Bid {
         bidder_(bidder),
         exclusive_(exclusive),
         preference_(std::numeric_limits<double>::quiet_NaN()),
-        package_(package) {}
+        package_(package),
+        ordinal_(-1) {}
 
   Bid(Request<T>* request, boost::shared_ptr<T> offer, Trader* bidder,
       typename BidPortfolio<T>::Ptr portfolio, bool exclusive,
@@ -122,7 +133,8 @@ template <class T> class Bid {
         portfolio_(portfolio),
         exclusive_(exclusive),
         preference_(preference),
-        package_(package) {}
+        package_(package),
+        ordinal_(-1) {}
 
   Bid(Request<T>* request, boost::shared_ptr<T> offer, Trader* bidder,
       typename BidPortfolio<T>::Ptr portfolio, bool exclusive = false,
@@ -133,7 +145,8 @@ template <class T> class Bid {
         portfolio_(portfolio),
         exclusive_(exclusive),
         preference_(std::numeric_limits<double>::quiet_NaN()),
-        package_(package) {}
+        package_(package),
+        ordinal_(-1) {}
 
   Request<T>* request_;
   boost::shared_ptr<T> offer_;
@@ -142,6 +155,7 @@ template <class T> class Bid {
   bool exclusive_;
   double preference_;
   Package::Ptr package_;
+  int ordinal_;
 };
 
 }  // namespace cyclus
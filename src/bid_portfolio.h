@@ -10,6 +10,7 @@
 #include "bid.h"
 #include "capacity_constraint.h"
 #include "error.h"
+#include "pool_base.h"
 
 namespace cyclus {
 
@@ -29,7 +30,8 @@ std::string GetTraderSpec(Trader* bidder);
 /// portfolio. Responses are grouped by the bidder. Constraints are assumed to
 /// act over the entire set of possible bids.
 template <class T>
-class BidPortfolio : public boost::enable_shared_from_this<BidPortfolio<T>> {
+class BidPortfolio : public boost::enable_shared_from_this<BidPortfolio<T>>,
+                     public PoolBase<BidPortfolio<T>> {
  public:
   typedef boost::shared_ptr<BidPortfolio<T>> Ptr;
 
@@ -30,6 +30,16 @@ template <class T> struct Converter {
   /// cyclus::TrivialConverter for an example
   virtual bool operator==(Converter& other) const { return false; }
   bool operator!=(Converter& other) const { return !operator==(other); }
+
+  /// @brief whether conversions may be memoized
+  ///
+  /// A converter may return true if convert() depends only on the offer's
+  /// quality (see Resource::qual_id) and is proportional to its quantity,
+  /// regardless of the arc and context. During translation, such a converter
+  /// (and all converters equal to it by operator==) is then evaluated only
+  /// once per distinct quality in an exchange, and its result is scaled to
+  /// each offer's quantity.
+  virtual bool memoizable() const { return false; }
 };
 
 /// @class TrivialConverter
@@ -48,6 +58,9 @@ template <class T> struct TrivialConverter : public Converter<T> {
   virtual bool operator==(Converter<T>& other) const {
     return dynamic_cast<TrivialConverter<T>*>(&other) != NULL;
   }
+
+  /// @returns true, the unit capacity is always 1
+  virtual bool memoizable() const { return true; }
 };
 
 /// @class CapacityConstraint
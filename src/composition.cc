@@ -1,7 +1,11 @@
 #include "composition.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include "comp_math.h"
 #include "context.h"
+#include "cyc_limits.h"
 #include "decayer.h"
 #include "error.h"
 #include "recorder.h"
@@ -12,7 +16,7 @@ extern "C" {
 
 namespace cyclus {
 
-int Composition::next_id_ = 1;
+IdAllocator Composition::next_id_(1);
 
 Composition::Ptr Composition::CreateFromAtom(CompMap v) {
   if (!compmath::ValidNucs(v)) throw ValueError("invalid nuclide in CompMap");
@@ -20,7 +24,7 @@ Composition::Ptr Composition::CreateFromAtom(CompMap v) {
   if (!compmath::AllPositive(v))
     throw ValueError("negative quantity in CompMap");
 
-  Composition::Ptr c(new Composition());
+  Composition::Ptr c = NewPooledPtr(new Composition());
   c->atom_ = v;
   return c;
 }
@@ -31,7 +35,7 @@ Composition::Ptr Composition::CreateFromMass(CompMap v) {
   if (!compmath::AllPositive(v))
     throw ValueError("negative quantity in CompMap");
 
-  Composition::Ptr c(new Composition());
+  Composition::Ptr c = NewPooledPtr(new Composition());
   c->mass_ = v;
   return c;
 }
@@ -41,40 +45,131 @@ int Composition::id() {
 }
 
 const CompMap& Composition::atom() {
-  if (atom_.size() == 0) {
-    CompMap::iterator it;
-    for (it = mass_.begin(); it != mass_.end(); ++it) {
-      Nuc nuc = it->first;
-      atom_[nuc] = it->second / pyne::atomic_mass(nuc);
+  std::call_once(atom_once_, [this]() {
+    if (atom_.size() == 0) {
+      CompMap::iterator it;
+      for (it = mass_.begin(); it != mass_.end(); ++it) {
+        Nuc nuc = it->first;
+        atom_[nuc] = it->second / pyne::atomic_mass(nuc);
+      }
     }
-  }
+  });
   return atom_;
 }
 
 const CompMap& Composition::mass() {
-  if (mass_.size() == 0) {
-    CompMap::iterator it;
-    for (it = atom_.begin(); it != atom_.end(); ++it) {
-      Nuc nuc = it->first;
-      mass_[nuc] = it->second * pyne::atomic_mass(nuc);
+  std::call_once(mass_once_, [this]() {
+    if (mass_.size() == 0) {
+      CompMap::iterator it;
+      for (it = atom_.begin(); it != atom_.end(); ++it) {
+        Nuc nuc = it->first;
+        mass_[nuc] = it->second * pyne::atomic_mass(nuc);
+      }
     }
-  }
+  });
   return mass_;
 }
 
+const CompMap& Composition::atom_norm() {
+  std::call_once(atom_norm_once_, [this]() {
+    atom_norm_ = atom();
+    compmath::Normalize(&atom_norm_);
+  });
+  return atom_norm_;
+}
+
+const CompMap& Composition::mass_norm() {
+  std::call_once(mass_norm_once_, [this]() {
+    mass_norm_ = mass();
+    compmath::Normalize(&mass_norm_);
+  });
+  return mass_norm_;
+}
+
+double Composition::decay_heat() {
+  std::call_once(decay_heat_once_, [this]() {
+    double heat = 0;
+    // Pyne decay heat operates with grams, cyclus generally in kilograms.
+    pyne::Material p_map = pyne::Material(mass(), 1000);
+    std::map<int, double> dec_heat = p_map.decay_heat();
+    for (auto nuc : dec_heat) {
+      if (!std::isnan(nuc.second)) {
+        heat += nuc.second;
+      }
+    }
+    decay_heat_ = heat;
+  });
+  return decay_heat_;
+}
+
+/// Returns the U-235 fraction of the uranium (U-235 + U-238) in v.
+static double U235Assay(const CompMap& v) {
+  CompMap::const_iterator it;
+  double u235 = (it = v.find(922350000)) != v.end() ? it->second : 0;
+  double u238 = (it = v.find(922380000)) != v.end() ? it->second : 0;
+  if (u235 + u238 > 0) {
+    return u235 / (u235 + u238);
+  }
+  return 0;
+}
+
+double Composition::u235_assay_atom() {
+  std::call_once(u235_assay_atom_once_,
+                 [this]() { u235_assay_atom_ = U235Assay(atom_norm()); });
+  return u235_assay_atom_;
+}
+
+double Composition::u235_assay_mass() {
+  std::call_once(u235_assay_mass_once_,
+                 [this]() { u235_assay_mass_ = U235Assay(mass_norm()); });
+  return u235_assay_mass_;
+}
+
+double Composition::fissile_frac() {
+  std::call_once(fissile_frac_once_, [this]() {
+    static const Nuc fissile[] = {922330000, 922350000, 942390000, 942410000};
+    const CompMap& v = mass_norm();
+    double frac = 0;
+    for (size_t i = 0; i < sizeof(fissile) / sizeof(fissile[0]); ++i) {
+      CompMap::const_iterator it = v.find(fissile[i]);
+      if (it != v.end()) {
+        frac += it->second;
+      }
+    }
+    fissile_frac_ = frac;
+  });
+  return fissile_frac_;
+}
+
 Composition::Ptr Composition::Decay(int delta, uint64_t secs_per_timestep) {
+  return Decay(delta, secs_per_timestep, false);
+}
+
+Composition::Ptr Composition::Decay(int delta, uint64_t secs_per_timestep,
+                                    bool link_parent) {
   int tot_decay = prev_decay_ + delta;
-  if (decay_line_->count(tot_decay) == 1) {
+  Composition::Ptr decayed;
+#pragma omp critical(cyclus_composition_decay_line)
+  {
+    Chain::iterator it = decay_line_->find(tot_decay);
+    if (it != decay_line_->end()) {
+      decayed = it->second;
+    }
+  }
+  if (decayed != NULL) {
     // decay_line_ has cached, pre-computed result of this decay
-    return (*decay_line_)[tot_decay];
+    return decayed;
   }
 
   // Calculate a new decayed composition and insert it into the decay chain.
   // It will automagically appear in the decay chain for all other compositions
   // that are a part of this decay chain because decay_line_ is a pointer that
-  // all compositions in the chain share.
-  Composition::Ptr decayed = NewDecay(delta, secs_per_timestep);
-  (*decay_line_)[tot_decay] = decayed;
+  // all compositions in the chain share. If another thread got there first,
+  // its result is kept so that the chain stays consistent.
+  decayed = NewDecay(delta, secs_per_timestep, link_parent);
+#pragma omp critical(cyclus_composition_decay_line)
+  decayed = decay_line_->insert(std::make_pair(tot_decay, decayed))
+                .first->second;
   return decayed;
 }
 
@@ -82,15 +177,85 @@ Composition::Ptr Composition::Decay(int delta) {
   return Decay(delta, kDefaultTimeStepDur);
 }
 
+double Composition::max_decay_const() {
+  std::call_once(max_decay_const_once_, [this]() {
+    double lambda = 0;
+    const CompMap& c = atom();
+    CompMap::const_iterator it;
+    for (it = c.begin(); it != c.end(); ++it) {
+      lambda = std::max(lambda, pyne::decay_const(it->first));
+    }
+    max_decay_const_ = lambda;
+  });
+  return max_decay_const_;
+}
+
+bool Composition::IsStable() {
+  return max_decay_const() == 0;
+}
+
+bool Composition::DecayNegligible(int delta, uint64_t secs_per_timestep,
+                                  double eps) {
+  if (IsStable()) {
+    return true;
+  }
+
+  std::pair<uint64_t, double> key(secs_per_timestep, eps);
+  int min_steps = 0;
+#pragma omp critical(cyclus_composition_decay_steps)
+  {
+    std::map<std::pair<uint64_t, double>, int>::iterator it =
+        min_decay_steps_.find(key);
+    if (it != min_decay_steps_.end()) {
+      min_steps = it->second;
+    }
+  }
+  if (min_steps == 0) {
+    // Decay is significant if (1 - eps) > exp(-lambda*dt), i.e. if
+    // dt >= -ln(1 - eps) / lambda.  The analytic estimate is nudged so the
+    // cached step count agrees exactly with evaluating the criterion directly.
+    double lambda_timesteps =
+        max_decay_const() * static_cast<double>(secs_per_timestep);
+    double steps = -std::log(1 - eps) / lambda_timesteps;
+    int n = steps >= CY_LARGE_INT ? CY_LARGE_INT
+                                  : std::max(1, static_cast<int>(steps));
+    while (n < CY_LARGE_INT &&
+           1.0 - std::exp(-lambda_timesteps * n) < eps) {
+      n++;
+    }
+    while (n > 1 && 1.0 - std::exp(-lambda_timesteps * (n - 1)) >= eps) {
+      n--;
+    }
+    min_steps = n;
+#pragma omp critical(cyclus_composition_decay_steps)
+    min_decay_steps_[key] = n;
+  }
+  return delta < min_steps;
+}
+
 void Composition::Record(Context* ctx) {
   if (recorded_) {
     return;
   }
   recorded_ = true;
 
+  // a parent that no longer exists may never have been recorded
+  Ptr parent = parent_.lock();
+  if (parent != NULL && ctx->sim_info().compact_decay_chains) {
+    parent->Record(ctx);
+    // TODO: when the backends get uint64_t support, the static_cast here
+    // should be removed.
+    ctx->NewDatum("DecayedCompositions")
+        ->AddVal("QualId", id())
+        ->AddVal("ParentQualId", parent->id())
+        ->AddVal("DecayTime", decay_delta_)
+        ->AddVal("TimeStepDur", static_cast<int>(decay_secs_per_timestep_))
+        ->Record();
+    return;
+  }
+
   CompMap::const_iterator it;
-  CompMap cm = mass();  // force lazy evaluation now
-  compmath::Normalize(&cm, 1);
+  const CompMap& cm = mass_norm();  // force lazy evaluation now
   for (it = cm.begin(); it != cm.end(); ++it) {
     ctx->NewDatum("Compositions")
         ->AddVal("QualId", id())
@@ -100,16 +265,32 @@ void Composition::Record(Context* ctx) {
   }
 }
 
-Composition::Composition() : prev_decay_(0), recorded_(false) {
-  id_ = next_id_;
-  next_id_++;
+Composition::Composition()
+    : prev_decay_(0),
+      recorded_(false),
+      decay_heat_(-1),
+      u235_assay_atom_(-1),
+      u235_assay_mass_(-1),
+      fissile_frac_(-1),
+      max_decay_const_(-1),
+      decay_delta_(0),
+      decay_secs_per_timestep_(0) {
+  id_ = next_id_.Next();
   decay_line_ = ChainPtr(new Chain());
 }
 
 Composition::Composition(int prev_decay, ChainPtr decay_line)
-    : recorded_(false), prev_decay_(prev_decay), decay_line_(decay_line) {
-  id_ = next_id_;
-  next_id_++;
+    : recorded_(false),
+      prev_decay_(prev_decay),
+      decay_line_(decay_line),
+      decay_heat_(-1),
+      u235_assay_atom_(-1),
+      u235_assay_mass_(-1),
+      fissile_frac_(-1),
+      max_decay_const_(-1),
+      decay_delta_(0),
+      decay_secs_per_timestep_(0) {
+  id_ = next_id_.Next();
 }
 
 std::string Composition::ToString(CompMap v) {
@@ -122,13 +303,20 @@ std::string Composition::ToString(CompMap v) {
   return comp;
 }
 
-Composition::Ptr Composition::NewDecay(int delta, uint64_t secs_per_timestep) {
+Composition::Ptr Composition::NewDecay(int delta, uint64_t secs_per_timestep,
+                                       bool link_parent) {
   int tot_decay = prev_decay_ + delta;
   atom();  // force evaluation of atom-composition if not calculated already
 
   // the new composition is a part of this decay chain and so is created with a
   // pointer to the exact same decay_line_.
-  Composition::Ptr decayed(new Composition(tot_decay, decay_line_));
+  Composition::Ptr decayed =
+      NewPooledPtr(new Composition(tot_decay, decay_line_));
+  if (link_parent) {
+    decayed->parent_ = weak_from_this();
+  }
+  decayed->decay_delta_ = delta;
+  decayed->decay_secs_per_timestep_ = secs_per_timestep;
 
   // FIXME this is only here for testing, see issue #761
   if (atom_.size() == 0) return decayed;
@@ -2,8 +2,15 @@
 #define CYCLUS_SRC_COMPOSITION_H_
 
 #include <map>
+#include <mutex>
+#include <utility>
 #include <stdint.h>
+#include <boost/enable_shared_from_this.hpp>
 #include <boost/shared_ptr.hpp>
+#include <boost/weak_ptr.hpp>
+
+#include "id_allocator.h"
+#include "pool_base.h"
 
 class SimInitTest;
 
@@ -35,7 +42,8 @@ typedef std::map<Nuc, double> CompMap;
 /// Composition c = Composition::CreateFromAtom(v);
 /// @endcode
 ///
-class Composition {
+class Composition : public boost::enable_shared_from_this<Composition>,
+                    public PoolBase<Composition> {
   friend class SimInit;
   friend class ::SimInitTest;
 
@@ -64,6 +72,32 @@ class Composition {
   /// Returns the unnormalized mass composition.
   const CompMap& mass();
 
+  /// Returns the atom composition normalized to 1.  The normalized map is
+  /// computed once and cached.
+  const CompMap& atom_norm();
+
+  /// Returns the mass composition normalized to 1.  The normalized map is
+  /// computed once and cached.
+  const CompMap& mass_norm();
+
+  /// Returns the decay heat of one kg of material with this composition in W.
+  /// The value is computed once and cached.
+  double decay_heat();
+
+  /// Returns the U-235 atom fraction of the uranium in this composition
+  /// (i.e. U-235 / (U-235 + U-238)), or zero if there is no uranium.  The
+  /// value is computed once and cached.
+  double u235_assay_atom();
+
+  /// Returns the U-235 mass fraction of the uranium in this composition
+  /// (i.e. U-235 / (U-235 + U-238)), or zero if there is no uranium.  The
+  /// value is computed once and cached.
+  double u235_assay_mass();
+
+  /// Returns the combined mass fraction of the fissile nuclides U-233, U-235,
+  /// Pu-239 and Pu-241.  The value is computed once and cached.
+  double fissile_frac();
+
   /// Returns a decayed version of this composition (decayed delta timesteps)
   /// assuming a time step is 1/12 of one year in duration. This composition
   /// remains unchanged.
@@ -73,8 +107,33 @@ class Composition {
   /// delta timesteps) using the seconds to timestep conversion specified.
   Ptr Decay(int delta, uint64_t secs_per_timestep);
 
+  /// Same as Decay(delta, secs_per_timestep), but if link_parent is true and
+  /// the decayed composition is newly computed, it refers back to this one
+  /// (without keeping it alive) so that it can be recorded as a decay of it
+  /// (see SimInfo::compact_decay_chains).
+  Ptr Decay(int delta, uint64_t secs_per_timestep, bool link_parent);
+
+  /// Returns the largest decay constant (in 1/s) of all nuclides in this
+  /// composition.  The value is computed once and cached.
+  double max_decay_const();
+
+  /// Returns true if no nuclide in this composition decays at all.
+  bool IsStable();
+
+  /// Returns true if decaying this composition for delta timesteps of
+  /// secs_per_timestep seconds would not change the number density of any
+  /// nuclide by more than a fraction eps.  The smallest significant delta is
+  /// cached per timestep size, so repeated checks are O(1).
+  bool DecayNegligible(int delta, uint64_t secs_per_timestep,
+                       double eps = 1e-3);
+
   /// Records the composition in output database Compositions table (if
-  /// not done previously).
+  /// not done previously).  If the simulation has compact decay chains
+  /// enabled and this composition was created by decaying another one, only
+  /// a (QualId, ParentQualId, DecayTime) row is written to the
+  /// DecayedCompositions table and the parent is recorded instead.  The full
+  /// composition can be reconstructed by decaying the parent again (see
+  /// SimInit::LoadComposition).
   void Record(Context* ctx);
 
   /// @brief Transforms a composition into a printable string, primarily for
@@ -100,9 +159,9 @@ class Composition {
   Composition(int prev_decay, ChainPtr decay_line);
 
   /// Performs a decay calculation and creates a new decayed composition.
-  Ptr NewDecay(int delta, uint64_t secs_per_timestep);
+  Ptr NewDecay(int delta, uint64_t secs_per_timestep, bool link_parent);
 
-  static int next_id_;
+  static IdAllocator next_id_;
   int id_;
   bool recorded_;
   CompMap atom_;
@@ -111,6 +170,42 @@ class Composition {
   /// the total time delta this composition has been decayed from its root
   /// ancestor.
   int prev_decay_;
+
+  /// the composition this one was decayed from (empty if not created by a
+  /// linked decay or if it no longer exists) along with the decay duration
+  /// used.
+  boost::weak_ptr<Composition> parent_;
+  int decay_delta_;
+  uint64_t decay_secs_per_timestep_;
+
+  /// lazily computed normalized compositions.
+  CompMap atom_norm_;
+  CompMap mass_norm_;
+
+  /// lazily computed derived quantities.
+  double decay_heat_;
+  double u235_assay_atom_;
+  double u235_assay_mass_;
+  double fissile_frac_;
+
+  /// cached maximum decay constant of all nuclides.
+  double max_decay_const_;
+
+  /// guard the lazy computations above, since compositions are shared by
+  /// agents that may run concurrently.
+  std::once_flag atom_once_;
+  std::once_flag mass_once_;
+  std::once_flag atom_norm_once_;
+  std::once_flag mass_norm_once_;
+  std::once_flag decay_heat_once_;
+  std::once_flag u235_assay_atom_once_;
+  std::once_flag u235_assay_mass_once_;
+  std::once_flag fissile_frac_once_;
+  std::once_flag max_decay_const_once_;
+
+  /// the smallest number of timesteps that produces a significant decay,
+  /// keyed on (timestep duration in seconds, eps).
+  std::map<std::pair<uint64_t, double>, int> min_decay_steps_;
 };
 
 }  // namespace cyclus
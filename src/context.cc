@@ -30,6 +30,8 @@ SimInfo::SimInfo()
       branch_time(-1),
       explicit_inventory(false),
       explicit_inventory_compact(false),
+      compact_decay_chains(false),
+      fast_forward(false),
       parent_sim(boost::uuids::nil_uuid()),
       parent_type("init"),
       seed(kDefaultSeed),
@@ -45,6 +47,8 @@ SimInfo::SimInfo(int dur, int y0, int m0, std::string handle)
       handle(handle),
       explicit_inventory(false),
       explicit_inventory_compact(false),
+      compact_decay_chains(false),
+      fast_forward(false),
       parent_sim(boost::uuids::nil_uuid()),
       parent_type("init"),
       seed(kDefaultSeed),
@@ -60,6 +64,8 @@ SimInfo::SimInfo(int dur, int y0, int m0, std::string handle, std::string d)
       handle(handle),
       explicit_inventory(false),
       explicit_inventory_compact(false),
+      compact_decay_chains(false),
+      fast_forward(false),
       parent_sim(boost::uuids::nil_uuid()),
       parent_type("init"),
       seed(kDefaultSeed),
@@ -77,6 +83,8 @@ SimInfo::SimInfo(int dur, boost::uuids::uuid parent_sim, int branch_time,
       branch_time(branch_time),
       explicit_inventory(false),
       explicit_inventory_compact(false),
+      compact_decay_chains(false),
+      fast_forward(false),
       handle(handle),
       seed(kDefaultSeed),
       stride(kDefaultStride) {}
@@ -133,6 +141,31 @@ void Context::SchedBuild(Agent* parent, std::string proto_name, int t) {
   }
 }
 
+void Context::SchedBuilds(Agent* parent, std::string proto_name, int n,
+                          int t) {
+  if (n < 0) {
+    throw ValueError("Cannot schedule a negative number of builds");
+  }
+
+#pragma omp critical
+  {
+    if (t == -1) {
+      t = time() + 1;
+    }
+    int pid = (parent != NULL) ? parent->id() : -1;
+    ti_->SchedBuild(parent, proto_name, t, n);
+    // one row per agent so that restarts schedule the same builds
+    for (int i = 0; i < n; ++i) {
+      NewDatum("BuildSchedule")
+          ->AddVal("ParentId", pid)
+          ->AddVal("Prototype", proto_name)
+          ->AddVal("SchedTime", time())
+          ->AddVal("BuildTime", t)
+          ->Record();
+    }
+  }
+}
+
 void Context::SchedDecom(Agent* m, int t) {
 #pragma omp critical
   {
@@ -286,6 +319,12 @@ void Context::InitSim(SimInfo si) {
 
   NewDatum("DecayMode")->AddVal("Decay", si.decay)->Record();
 
+  NewDatum("InfoDecayChains")
+      ->AddVal("CompactDecayChains", si.compact_decay_chains)
+      ->Record();
+
+  NewDatum("InfoFastForward")->AddVal("FastForward", si.fast_forward)->Record();
+
   NewDatum("InfoExplicitInv")
       ->AddVal("RecordInventory", si.explicit_inventory)
       ->AddVal("RecordInventoryCompact", si.explicit_inventory_compact)
@@ -348,6 +387,19 @@ void Context::UnregisterTimeListener(TimeListener* tl) {
   ti_->UnregisterTimeListener(tl);
 }
 
+void Context::Sleep(TimeListener* tl, int t, bool wake_on_trade,
+                    bool dre_idle) {
+  ti_->Sleep(tl, t, wake_on_trade, dre_idle);
+}
+
+void Context::Wake(TimeListener* tl) {
+  ti_->Wake(tl);
+}
+
+void Context::NotifyTrade(Agent* a) {
+  ti_->NotifyTrade(a);
+}
+
 Datum* Context::NewDatum(std::string title) {
   return rec_->NewDatum(title);
 }
@@ -4,6 +4,7 @@
 #include <map>
 #include <set>
 #include <string>
+#include <vector>
 #include <stdint.h>
 
 #ifndef CYCPP
@@ -19,6 +20,7 @@
 #include "pyhooks.h"
 #include "recorder.h"
 #include "package.h"
+#include "profiler.h"
 
 // Defined as 4 seconds longer than a Gaussian year (to make division by 12
 // a round number)
@@ -122,6 +124,17 @@ class SimInfo {
   /// Composition-object and/or reference).
   bool explicit_inventory_compact;
 
+  /// True if decayed compositions should be recorded compactly as a
+  /// reference to their parent composition and decay time instead of their
+  /// full nuclide vectors (see Composition::Record).
+  bool compact_decay_chains;
+
+  /// True if the timer may skip quiet time steps, during which no agent is
+  /// awake, every trading agent sleeps idle on the exchange (see
+  /// Context::Sleep), nothing is built or decommissioned and no trades occur
+  /// (see Timer::RunSim).
+  bool fast_forward;
+
   /// Seed for random number generator
   uint64_t seed;
 
@@ -210,6 +223,39 @@ class Context {
     return casted;
   }
 
+  /// Creates n new agents by cloning the named prototype and appends them to
+  /// agents. The prototype is looked up once and the storage for the new
+  /// agents is reserved up front, so this should be preferred over
+  /// CreateAgent for deploying many identical agents. The returned agents are
+  /// not initialized as simulation participants.
+  ///
+  /// @warning this method should generally NOT be used by agents.
+  template <class T>
+  void CreateAgents(std::string proto_name, int n, std::vector<T*>* agents) {
+    std::map<std::string, Agent*>::iterator it = protos_.find(proto_name);
+    if (it == protos_.end()) {
+      throw KeyError("Invalid prototype name " + proto_name);
+    } else if (it->second == NULL) {
+      throw KeyError("Null prototype for " + proto_name);
+    }
+
+    Agent* m = it->second;
+    agents->reserve(agents->size() + n);
+    for (int i = 0; i < n; ++i) {
+      Agent* clone = m->Clone();
+      if (clone == NULL) {
+        throw StateError("Clone operation failed for " + proto_name);
+      }
+      T* casted = dynamic_cast<T*>(clone);
+      if (casted == NULL) {
+        PyDelAgent(clone->id());
+        DelAgent(clone);
+        throw CastError("Invalid cast for prototype " + proto_name);
+      }
+      agents->push_back(casted);
+    }
+  }
+
   /// Destructs and cleans up m (and it's children recursively).
   ///
   /// @warning this method should generally NOT be used by agents.
@@ -220,6 +266,14 @@ class Context {
   /// next build phase (i.e. the start of the next timestep).
   void SchedBuild(Agent* parent, std::string proto_name, int t = -1);
 
+  /// Schedules n agents of the named prototype to be built for the specified
+  /// parent at timestep t (see SchedBuild). They are cloned and built
+  /// together, which is much faster than scheduling each of them separately
+  /// when deploying large fleets of identical agents.
+  ///
+  /// @throws ValueError if n is negative
+  void SchedBuilds(Agent* parent, std::string proto_name, int n, int t = -1);
+
   /// Schedules the given Agent to be decommissioned at the specified timestep
   /// t. The default t=-1 results in the decommission being scheduled for the
   /// next decommission phase (i.e. the end of the current timestep).
@@ -243,6 +297,28 @@ class Context {
   /// Agents should unregister from their Decommission method.
   void UnregisterTimeListener(TimeListener* tl);
 
+  /// Stops notifying a registered TimeListener of Tick, Tock and Decision
+  /// after the current phase until the Tick of timestep t, so that agents
+  /// that are idle for a while are not called at all in the meantime.
+  /// Sleeping agents still trade. If wake_on_trade is true, they are woken
+  /// (from the next phase on) whenever they are party to a trade. If
+  /// dre_idle is true, the agent promises that it neither requests nor bids
+  /// while asleep, which lets the timer skip time steps in which all agents
+  /// are asleep (see SimInfo::fast_forward). Sleep state is not part of
+  /// simulation snapshots.
+  ///
+  /// @throws ValueError if t is not after the current timestep
+  void Sleep(TimeListener* tl, int t, bool wake_on_trade = false,
+             bool dre_idle = false);
+
+  /// Resumes notifying a sleeping TimeListener from the next phase on, e.g.,
+  /// after it has received a resource.
+  void Wake(TimeListener* tl);
+
+  /// Wakes a sleeping agent that asked to be woken by trades. It is called
+  /// for both parties of every executed trade.
+  void NotifyTrade(Agent* a);
+
   /// Initializes the simulation time parameters. Should only be called once -
   /// NOT idempotent.
   void InitSim(SimInfo si);
@@ -250,6 +326,9 @@ class Context {
   /// Returns the current simulation timestep.
   virtual int time();
 
+  /// Returns the profiler measuring simulation phases and agent callbacks.
+  inline Profiler* profiler() { return &profiler_; }
+
   /// Adds a package type to a simulation-wide accessible list.
   /// Agents should NOT add their own packages.
   void AddPackage(std::string name, double fill_min = 0,
@@ -374,6 +453,7 @@ class Context {
   Recorder* rec_;
   int trans_id_;
   RandomNumberGenerator* rng_;
+  Profiler profiler_;
 };
 
 }  // namespace cyclus
@@ -38,6 +38,7 @@ extern "C" {
 #include "error.h"
 #include "facility.h"
 #include "product.h"
+#include "profiler.h"
 #include "institution.h"
 #include "logger.h"
 #include "material.h"
@@ -71,6 +72,7 @@ extern "C" {
 #include "toolkit/enrichment.h"
 #include "toolkit/infile_converters.h"
 #include "toolkit/mat_query.h"
+#include "toolkit/offer_cache.h"
 #include "toolkit/position.h"
 #include "toolkit/res_buf.h"
 #include "toolkit/res_manip.h"
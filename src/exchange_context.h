@@ -4,12 +4,14 @@
 #include <assert.h>
 #include <map>
 #include <cmath>
+#include <set>
 #include <string>
 #include <utility>
 #include <vector>
 
 #include "bid.h"
 #include "bid_portfolio.h"
+#include "error.h"
 #include "request.h"
 #include "request_portfolio.h"
 
@@ -26,6 +28,27 @@ template <class T> struct PrefMap {
   typedef Bid<T>* bid_ptr;
 };
 
+/// @brief Records, per thread, whether a call to AdjustMatlPrefs or
+/// AdjustProductPrefs reached one of the default implementations, which leave
+/// the preferences unchanged. The ResourceExchange uses this to learn which
+/// agent types do not adjust preferences, so that it need not build the
+/// nested PrefMap for them.
+class DefaultPrefs {
+ public:
+  /// @brief called by the default implementations
+  static void Reached() { reached_ = true; }
+
+  /// @return whether a default implementation was reached since the last call
+  static bool Take() {
+    bool reached = reached_;
+    reached_ = false;
+    return reached;
+  }
+
+ private:
+  inline static thread_local bool reached_ = false;
+};
+
 template <class T> struct CommodMap {
   typedef std::map<std::string, std::vector<Request<T>*>> type;
   typedef Request<T>* request_ptr;
@@ -43,8 +66,15 @@ template <class T> struct CommodMap {
 /// Exchange. The second phase, Response to Request for Bids, is assisted by
 /// grouping requests by commodity type. The third phase, preference adjustment,
 /// is assisted by grouping bids by the requester being responded to.
+///
+/// Preferences are kept in a flat array indexed by the bids' ordinals (see
+/// Bid::ordinal; each bid responds to exactly one request), from which Pref()
+/// looks them up in constant time. The nested per-requester view that traders
+/// adjust, trader_prefs, is only built on demand by BuildPrefs(), and
+/// FlattenPrefs() copies it back into the flat array.
 template <class T> struct ExchangeContext {
  public:
+
   /// @brief adds a request to the context
   void AddRequestPortfolio(const typename RequestPortfolio<T>::Ptr port) {
     requests.push_back(port);
@@ -86,9 +116,66 @@ template <class T> struct ExchangeContext {
     bids_by_request[pb->request()].push_back(pb);
 
     double bid_pref = pb->preference();
-    trader_prefs[pb->request()->requester()][pb->request()].insert(
-        std::make_pair(
-            pb, std::isnan(bid_pref) ? pb->request()->preference() : bid_pref));
+    bid_pref = std::isnan(bid_pref) ? pb->request()->preference() : bid_pref;
+    if (!Contains(pb)) {
+      pb->ordinal_ = flat_bids.size();
+      flat_bids.push_back(pb);
+      bid_prefs.push_back(bid_pref);
+    }
+  }
+
+  /// @return true if the bid has been added to this exchange
+  inline bool Contains(const Bid<T>* pb) const {
+    return pb->ordinal() >= 0 &&
+           pb->ordinal() < static_cast<int>(flat_bids.size()) &&
+           flat_bids[pb->ordinal()] == pb;
+  }
+
+  /// @brief builds the trader_prefs entries of the given requesters from
+  /// bid_prefs. Each requester gets an entry, even if it received no bids.
+  void BuildPrefs(const std::set<Trader*>& reqrs) {
+    std::set<Trader*>::const_iterator t_it;
+    for (t_it = reqrs.begin(); t_it != reqrs.end(); ++t_it) {
+      trader_prefs[*t_it];
+    }
+    typename std::map<Request<T>*, std::vector<Bid<T>*>>::iterator r_it;
+    for (r_it = bids_by_request.begin(); r_it != bids_by_request.end();
+         ++r_it) {
+      Trader* reqr = r_it->first->requester();
+      if (reqrs.count(reqr) == 0) {
+        continue;
+      }
+      std::map<Bid<T>*, double>& prefs = trader_prefs[reqr][r_it->first];
+      for (int i = 0; i < r_it->second.size(); ++i) {
+        Bid<T>* pb = r_it->second[i];
+        prefs[pb] = bid_prefs[pb->ordinal()];
+      }
+    }
+  }
+
+  /// @brief copies the (adjusted) preferences in trader_prefs into bid_prefs
+  void FlattenPrefs() {
+    typename std::map<Trader*, typename PrefMap<T>::type>::iterator t_it;
+    for (t_it = trader_prefs.begin(); t_it != trader_prefs.end(); ++t_it) {
+      typename PrefMap<T>::type::iterator r_it;
+      for (r_it = t_it->second.begin(); r_it != t_it->second.end(); ++r_it) {
+        typename std::map<Bid<T>*, double>::iterator b_it;
+        for (b_it = r_it->second.begin(); b_it != r_it->second.end(); ++b_it) {
+          if (Contains(b_it->first)) {
+            bid_prefs[b_it->first->ordinal()] = b_it->second;
+          }
+        }
+      }
+    }
+  }
+
+  /// @return the preference of a bid for its request
+  /// @throws KeyError if the bid is not part of the exchange
+  inline double Pref(const Bid<T>* pb) const {
+    if (!Contains(pb)) {
+      throw KeyError("bid is not part of the exchange");
+    }
+    return bid_prefs[pb->ordinal()];
   }
 
   /// @brief a reference to an exchange's set of requests
@@ -109,8 +196,15 @@ template <class T> struct ExchangeContext {
   /// @brief maps request to all bids for request
   std::map<Request<T>*, std::vector<Bid<T>*>> bids_by_request;
 
-  /// @brief maps commodity name to requests for that commodity
+  /// @brief maps requesters to the preferences of the bids for their requests,
+  /// only filled by BuildPrefs()
   std::map<Trader*, typename PrefMap<T>::type> trader_prefs;
+
+  /// @brief the bids in the order they were added, i.e., by ordinal
+  std::vector<Bid<T>*> flat_bids;
+
+  /// @brief the preference of each bid (by ordinal) for its request
+  std::vector<double> bid_prefs;
 };
 
 }  // namespace cyclus
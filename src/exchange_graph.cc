@@ -101,26 +101,50 @@ void RequestGroup::AddExchangeNode(ExchangeNode::Ptr node) {
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
-ExchangeGraph::ExchangeGraph() : next_arc_id_(0) {}
+ExchangeGraph::ExchangeGraph()
+    : maps_dirty_(false), n_from_nodes_(0), compact_dirty_(true) {
+  compact_.ucap_start.push_back(0);
+  compact_.vcap_start.push_back(0);
+}
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ExchangeGraph::AddRequestGroup(RequestGroup::Ptr prs) {
   request_groups_.push_back(prs);
+  compact_dirty_ = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ExchangeGraph::AddSupplyGroup(ExchangeNodeGroup::Ptr pss) {
   supply_groups_.push_back(pss);
+  compact_dirty_ = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 void ExchangeGraph::AddArc(const Arc& a) {
+  // the data is filled in from the nodes' maps by BuildCompact
+  AddArc(a, 0, NULL, 0, NULL, 0);
+  arc_from_nodes_.back() = 1;
+  n_from_nodes_++;
+}
+
+void ExchangeGraph::AddArc(const Arc& a, double pref,
+                           const std::vector<double>& ucaps,
+                           const std::vector<double>& vcaps) {
+  AddArc(a, pref, ucaps.data(), ucaps.size(), vcaps.data(), vcaps.size());
+}
+
+void ExchangeGraph::AddArc(const Arc& a, double pref, const double* ucaps,
+                           int nu, const double* vcaps, int nv) {
   arcs_.push_back(a);
-  int id = next_arc_id_++;
-  arc_ids_.insert(std::pair<Arc, int>(a, id));
-  arc_by_id_.insert(std::pair<int, Arc>(id, a));
-  node_arc_map_[a.unode()].push_back(a);
-  node_arc_map_[a.vnode()].push_back(a);
+  arc_from_nodes_.push_back(0);
+  CompactGraph& cg = compact_;
+  cg.arc_pref.push_back(pref);
+  cg.ucaps.insert(cg.ucaps.end(), ucaps, ucaps + nu);
+  cg.ucap_start.push_back(cg.ucaps.size());
+  cg.vcaps.insert(cg.vcaps.end(), vcaps, vcaps + nv);
+  cg.vcap_start.push_back(cg.vcaps.size());
+  maps_dirty_ = true;
+  compact_dirty_ = true;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -128,4 +152,323 @@ void ExchangeGraph::AddMatch(const Arc& a, double qty) {
   matches_.push_back(std::make_pair(a, qty));
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const CompactGraph& ExchangeGraph::compact() const {
+  if (compact_dirty_) {
+    BuildCompact();
+    compact_dirty_ = false;
+  }
+  return compact_;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+namespace {
+
+/// the component of group g, or -1 if g has no arcs or is not in the graph
+int GroupComponent(int g, const std::vector<int>& parent,
+                   const std::vector<int>& comp) {
+  if (g < 0) {
+    return -1;
+  }
+  while (parent[g] != g) {
+    g = parent[g];
+  }
+  return comp[g];
+}
+
+}  // namespace
+
+std::vector<ExchangeGraph::Ptr> ExchangeGraph::Components() const {
+  const CompactGraph& cg = compact();
+  int ngroups = cg.n_groups();
+
+  // union-find over groups, nodes without a group are their own item
+  std::vector<int> parent(ngroups + cg.n_nodes());
+  for (int i = 0; i < parent.size(); ++i) {
+    parent[i] = i;
+  }
+  std::vector<int> arc_root(cg.n_arcs());
+  for (int pass = 0; pass < 2; ++pass) {
+    for (int i = 0; i < cg.n_arcs(); ++i) {
+      int ends[2] = {cg.arc_unode[i], cg.arc_vnode[i]};
+      for (int j = 0; j < 2; ++j) {
+        int n = ends[j];
+        int item = cg.node_group[n] >= 0 ? cg.node_group[n] : ngroups + n;
+        while (parent[item] != item) {
+          parent[item] = parent[parent[item]];
+          item = parent[item];
+        }
+        ends[j] = item;
+      }
+      if (pass == 0) {
+        parent[std::max(ends[0], ends[1])] = std::min(ends[0], ends[1]);
+      } else {
+        arc_root[i] = ends[0];
+      }
+    }
+  }
+
+  // number components in order of their first arc
+  std::vector<int> comp(parent.size(), -1);
+  std::vector<ExchangeGraph::Ptr> subs;
+  for (int i = 0; i < cg.n_arcs(); ++i) {
+    if (comp[arc_root[i]] < 0) {
+      comp[arc_root[i]] = subs.size();
+      subs.push_back(ExchangeGraph::Ptr(new ExchangeGraph()));
+    }
+  }
+
+  // groups in their current order, which may differ from their ids if they
+  // have been reordered since the compact graph was built
+  for (int i = 0; i < request_groups_.size(); ++i) {
+    int c = GroupComponent(cg.group_id(request_groups_[i].get()), parent, comp);
+    if (c >= 0) {
+      subs[c]->AddRequestGroup(request_groups_[i]);
+    }
+  }
+  for (int i = 0; i < supply_groups_.size(); ++i) {
+    int c = GroupComponent(cg.group_id(supply_groups_[i].get()), parent, comp);
+    if (c >= 0) {
+      subs[c]->AddSupplyGroup(supply_groups_[i]);
+    }
+  }
+
+  // the arc data is copied from the compact graph, the nodes' maps are not
+  // read again
+  for (int i = 0; i < cg.n_arcs(); ++i) {
+    int us = cg.ucap_start[i];
+    int vs = cg.vcap_start[i];
+    subs[comp[arc_root[i]]]->AddArc(
+        arcs_[i], cg.arc_pref[i], cg.ucaps.data() + us,
+        cg.ucap_start[i + 1] - us, cg.vcaps.data() + vs,
+        cg.vcap_start[i + 1] - vs);
+  }
+  return subs;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+const std::map<ExchangeNode::Ptr, std::vector<Arc>>&
+ExchangeGraph::node_arc_map() const {
+  BuildMaps();
+  return node_arc_map_;
+}
+
+std::map<ExchangeNode::Ptr, std::vector<Arc>>& ExchangeGraph::node_arc_map() {
+  BuildMaps();
+  return node_arc_map_;
+}
+
+const std::map<Arc, int>& ExchangeGraph::arc_ids() const {
+  BuildMaps();
+  return arc_ids_;
+}
+
+std::map<Arc, int>& ExchangeGraph::arc_ids() {
+  BuildMaps();
+  return arc_ids_;
+}
+
+const std::map<int, Arc>& ExchangeGraph::arc_by_id() const {
+  BuildMaps();
+  return arc_by_id_;
+}
+
+std::map<int, Arc>& ExchangeGraph::arc_by_id() {
+  BuildMaps();
+  return arc_by_id_;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+void ExchangeGraph::BuildMaps() const {
+  if (!maps_dirty_) {
+    return;
+  }
+  node_arc_map_.clear();
+  arc_ids_.clear();
+  arc_by_id_.clear();
+  for (int i = 0; i < arcs_.size(); ++i) {
+    const Arc& a = arcs_[i];
+    arc_ids_.insert(std::pair<Arc, int>(a, i));
+    arc_by_id_.insert(std::pair<int, Arc>(i, a));
+    node_arc_map_[a.unode()].push_back(a);
+    node_arc_map_[a.vnode()].push_back(a);
+  }
+  maps_dirty_ = false;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+namespace {
+
+int AddCompactNode(CompactGraph* cg, ExchangeNode* n, int group) {
+  std::pair<std::unordered_map<const ExchangeNode*, int>::iterator, bool> res =
+      cg->node_ids.insert(std::make_pair(n, cg->n_nodes()));
+  if (res.second) {
+    cg->nodes.push_back(n);
+    cg->node_group.push_back(group);
+    cg->node_qty.push_back(n->qty);
+  }
+  return res.first->second;
+}
+
+void AddCompactGroup(CompactGraph* cg, ExchangeNodeGroup* g) {
+  int gid = cg->n_groups();
+  cg->groups.push_back(g);
+  cg->group_ids[g] = gid;
+  const std::vector<double>& caps = g->capacities();
+  cg->group_caps.insert(cg->group_caps.end(), caps.begin(), caps.end());
+  cg->group_cap_start.push_back(cg->group_caps.size());
+  const std::vector<ExchangeNode::Ptr>& nodes = g->nodes();
+  for (int i = 0; i < nodes.size(); ++i) {
+    AddCompactNode(cg, nodes[i].get(), gid);
+  }
+}
+
+void AppendUnitCaps(const ExchangeNode* n, const Arc& a,
+                    std::vector<int>* start, std::vector<double>* caps) {
+  std::map<Arc, std::vector<double>>::const_iterator it =
+      n->unit_capacities.find(a);
+  if (it != n->unit_capacities.end()) {
+    caps->insert(caps->end(), it->second.begin(), it->second.end());
+  }
+  start->push_back(caps->size());
+}
+
+/// appends the unit capacities of arc i in (from_start, from) instead
+void AppendUnitCaps(const std::vector<int>& from_start,
+                    const std::vector<double>& from, int i,
+                    std::vector<int>* start, std::vector<double>* caps) {
+  caps->insert(caps->end(), from.begin() + from_start[i],
+               from.begin() + from_start[i + 1]);
+  start->push_back(caps->size());
+}
+
+}  // namespace
+
+void ExchangeGraph::BuildCompact() const {
+  // the arc data stored by AddArc is kept, all indices are rebuilt
+  CompactGraph& cg = compact_;
+  CompactGraph data;
+  data.arc_pref.swap(cg.arc_pref);
+  data.ucap_start.swap(cg.ucap_start);
+  data.ucaps.swap(cg.ucaps);
+  data.vcap_start.swap(cg.vcap_start);
+  data.vcaps.swap(cg.vcaps);
+  cg = CompactGraph();
+
+  // groups and their nodes
+  cg.group_cap_start.push_back(0);
+  for (int i = 0; i < request_groups_.size(); ++i) {
+    AddCompactGroup(&cg, request_groups_[i].get());
+  }
+  cg.n_request_groups = cg.n_groups();
+  for (int i = 0; i < supply_groups_.size(); ++i) {
+    AddCompactGroup(&cg, supply_groups_[i].get());
+  }
+
+  // arc endpoints and exclusivity
+  int narcs = arcs_.size();
+  cg.arc_unode.reserve(narcs);
+  cg.arc_vnode.reserve(narcs);
+  cg.arc_excl_val.reserve(narcs);
+  cg.arc_exclusive.reserve(narcs);
+  for (int i = 0; i < narcs; ++i) {
+    const Arc& a = arcs_[i];
+    ExchangeNode::Ptr u = a.unode();
+    ExchangeNode::Ptr v = a.vnode();
+    // endpoints that are not members of the graph's groups are still given
+    // ids so that every arc is representable
+    int uid = cg.node_id(u.get());
+    if (uid < 0) {
+      uid = AddCompactNode(&cg, u.get(), cg.group_id(u->group));
+    }
+    int vid = cg.node_id(v.get());
+    if (vid < 0) {
+      vid = AddCompactNode(&cg, v.get(), cg.group_id(v->group));
+    }
+    cg.arc_unode.push_back(uid);
+    cg.arc_vnode.push_back(vid);
+    cg.arc_exclusive.push_back(a.exclusive());
+    cg.arc_excl_val.push_back(a.excl_val());
+  }
+
+  // arc data, only arcs added without it are read from their nodes' maps
+  if (n_from_nodes_ == 0) {
+    cg.arc_pref.swap(data.arc_pref);
+    cg.ucap_start.swap(data.ucap_start);
+    cg.ucaps.swap(data.ucaps);
+    cg.vcap_start.swap(data.vcap_start);
+    cg.vcaps.swap(data.vcaps);
+  } else {
+    cg.arc_pref.reserve(narcs);
+    cg.ucap_start.reserve(narcs + 1);
+    cg.vcap_start.reserve(narcs + 1);
+    cg.ucap_start.push_back(0);
+    cg.vcap_start.push_back(0);
+    for (int i = 0; i < narcs; ++i) {
+      if (!arc_from_nodes_[i]) {
+        cg.arc_pref.push_back(data.arc_pref[i]);
+        AppendUnitCaps(data.ucap_start, data.ucaps, i, &cg.ucap_start,
+                       &cg.ucaps);
+        AppendUnitCaps(data.vcap_start, data.vcaps, i, &cg.vcap_start,
+                       &cg.vcaps);
+        continue;
+      }
+
+      const Arc& a = arcs_[i];
+      ExchangeNode::Ptr u = a.unode();
+      ExchangeNode::Ptr v = a.vnode();
+      std::map<Arc, double>::const_iterator p_it = u->prefs.find(a);
+      cg.arc_pref.push_back(p_it != u->prefs.end() ? p_it->second : 0);
+      AppendUnitCaps(u.get(), a, &cg.ucap_start, &cg.ucaps);
+      AppendUnitCaps(v.get(), a, &cg.vcap_start, &cg.vcaps);
+    }
+  }
+
+  // CSR adjacency, arcs in insertion order for each node
+  int nnodes = cg.n_nodes();
+  cg.adj_start.assign(nnodes + 1, 0);
+  for (int i = 0; i < narcs; ++i) {
+    cg.adj_start[cg.arc_unode[i] + 1]++;
+    cg.adj_start[cg.arc_vnode[i] + 1]++;
+  }
+  for (int n = 0; n < nnodes; ++n) {
+    cg.adj_start[n + 1] += cg.adj_start[n];
+  }
+  cg.adj_arcs.resize(2 * narcs);
+  std::vector<int> fill(cg.adj_start.begin(), cg.adj_start.end() - 1);
+  for (int i = 0; i < narcs; ++i) {
+    cg.adj_arcs[fill[cg.arc_unode[i]]++] = i;
+    cg.adj_arcs[fill[cg.arc_vnode[i]]++] = i;
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int CompactGraph::arc_id(int u, int v) const {
+  if (u < 0 || u >= n_nodes()) {
+    return -1;
+  }
+  for (int k = adj_start[u]; k != adj_start[u + 1]; ++k) {
+    int a = adj_arcs[k];
+    if (arc_unode[a] == u && arc_vnode[a] == v) {
+      return a;
+    }
+  }
+  return -1;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+std::vector<ArcKey> ArcKeys(const ExchangeGraph& g) {
+  const std::vector<Arc>& arcs = g.arcs();
+  std::vector<ArcKey> keys(arcs.size());
+  std::map<ArcKey, int> counts;
+  for (int i = 0; i < arcs.size(); ++i) {
+    ArcKey& k = keys[i];
+    k.requester = arcs[i].unode()->agent_id;
+    k.bidder = arcs[i].vnode()->agent_id;
+    k.commod = arcs[i].unode()->commod;
+    k.n = counts[k]++;
+  }
+  return keys;
+}
+
 }  // namespace cyclus
@@ -4,6 +4,7 @@
 #include <limits>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -40,9 +41,14 @@ struct ExchangeNode {
   /// @brief unit values associated with this ExchangeNode corresponding to
   /// capacties of its parent ExchangeNodeGroup. This information corresponds to
   /// the resource object from which this ExchangeNode was translated.
+  ///
+  /// Only read for arcs added with ExchangeGraph::AddArc(const Arc&), i.e.,
+  /// graphs built by hand. The ExchangeTranslator passes an arc's unit
+  /// capacities to the graph directly and leaves this empty; solvers read
+  /// them from ExchangeGraph::compact().
   std::map<Arc, std::vector<double>> unit_capacities;
 
-  /// @brief preference values for arcs
+  /// @brief preference values for arcs, read like unit_capacities
   std::map<Arc, double> prefs;
 
   /// @brief whether this node represents an exclusive request or offer
@@ -149,7 +155,8 @@ class ExchangeNodeGroup {
     excl_node_groups_.push_back(nodes);
   }
 
-  /// @return true of any nodes have arcs associated with them
+  /// @return true of any nodes have arcs associated with them (through
+  /// their prefs, see ExchangeNode::prefs)
   bool HasArcs() {
     for (std::vector<ExchangeNode::Ptr>::iterator it = nodes_.begin();
          it != nodes_.end();
@@ -195,6 +202,114 @@ class RequestGroup : public ExchangeNodeGroup {
 
 typedef std::pair<Arc, double> Match;
 
+/// @brief ArcKey identifies an arc across exchanges (e.g., in consecutive time
+/// steps) by the agent ids of its request and bid nodes, the commodity of its
+/// request node and, among arcs that share these, its order in the graph.
+struct ArcKey {
+  ArcKey() : requester(-1), bidder(-1), n(0) {}
+
+  int requester;
+  int bidder;
+  std::string commod;
+  int n;
+
+  inline bool operator<(const ArcKey& rhs) const {
+    if (requester != rhs.requester) return requester < rhs.requester;
+    if (bidder != rhs.bidder) return bidder < rhs.bidder;
+    if (commod != rhs.commod) return commod < rhs.commod;
+    return n < rhs.n;
+  }
+
+  inline bool operator==(const ArcKey& rhs) const {
+    return requester == rhs.requester && bidder == rhs.bidder &&
+           commod == rhs.commod && n == rhs.n;
+  }
+};
+
+/// @class CompactGraph
+///
+/// @brief An index-based, structure-of-arrays representation of an
+/// ExchangeGraph used by the solvers. Nodes, node groups and arcs are
+/// identified by contiguous integer ids; per-arc data (preference, exclusive
+/// value, unit capacities) is stored in flat arrays indexed by arc id, and the
+/// arcs incident on each node are stored in compressed sparse row (CSR) form.
+///
+/// Node ids follow the order of the graph's request groups then supply groups
+/// (and their nodes) at the time the representation was built; arc ids are
+/// identical to the ExchangeGraph's arc ids (i.e., the index into arcs()).
+/// Reordering groups or their nodes in place afterwards (e.g., by a
+/// preconditioner) leaves all ids valid, so solvers follow the order of the
+/// graph's groups and look up ids with node_id() and group_id().
+struct CompactGraph {
+  CompactGraph() : n_request_groups(0) {}
+
+  /// @brief the number of nodes
+  inline int n_nodes() const { return nodes.size(); }
+
+  /// @brief the number of arcs
+  inline int n_arcs() const { return arc_unode.size(); }
+
+  /// @brief the number of node groups
+  inline int n_groups() const { return groups.size(); }
+
+  /// @return the id of node n or -1 if it is not part of the graph
+  inline int node_id(const ExchangeNode* n) const {
+    std::unordered_map<const ExchangeNode*, int>::const_iterator it =
+        node_ids.find(n);
+    return it == node_ids.end() ? -1 : it->second;
+  }
+
+  /// @return the id of group g or -1 if it is not part of the graph
+  inline int group_id(const ExchangeNodeGroup* g) const {
+    std::unordered_map<const ExchangeNodeGroup*, int>::const_iterator it =
+        group_ids.find(g);
+    return it == group_ids.end() ? -1 : it->second;
+  }
+
+  /// @return the id of the first arc from node u to node v, or -1 if there is
+  /// none
+  int arc_id(int u, int v) const;
+
+  /// @brief the node at each node id
+  std::vector<ExchangeNode*> nodes;
+  /// @brief the group id of each node (-1 if its group is not in the graph)
+  std::vector<int> node_group;
+  /// @brief the maximum quantity of each node
+  std::vector<double> node_qty;
+
+  /// @brief the node groups, request groups first (ids [0,
+  /// n_request_groups)) followed by supply groups
+  std::vector<ExchangeNodeGroup*> groups;
+  int n_request_groups;
+  /// @brief the capacities of group g are group_caps[group_cap_start[g]] to
+  /// group_caps[group_cap_start[g + 1] - 1]
+  std::vector<int> group_cap_start;
+  std::vector<double> group_caps;
+
+  /// @brief request (u) and bid (v) node ids of each arc
+  std::vector<int> arc_unode;
+  std::vector<int> arc_vnode;
+  /// @brief the request node's preference for each arc
+  std::vector<double> arc_pref;
+  std::vector<double> arc_excl_val;
+  std::vector<char> arc_exclusive;
+  /// @brief the unit capacities of arc a w.r.t. its unode are
+  /// ucaps[ucap_start[a]] to ucaps[ucap_start[a + 1] - 1] (similarly for the
+  /// vnode)
+  std::vector<int> ucap_start;
+  std::vector<double> ucaps;
+  std::vector<int> vcap_start;
+  std::vector<double> vcaps;
+
+  /// @brief the arcs incident on node n are adj_arcs[adj_start[n]] to
+  /// adj_arcs[adj_start[n + 1] - 1], in the order they were added
+  std::vector<int> adj_start;
+  std::vector<int> adj_arcs;
+
+  std::unordered_map<const ExchangeNode*, int> node_ids;
+  std::unordered_map<const ExchangeNodeGroup*, int> group_ids;
+};
+
 /// @class ExchangeGraph
 ///
 /// @brief An ExchangeGraph is a resource-neutral representation of a
@@ -203,6 +318,12 @@ typedef std::pair<Arc, double> Match;
 /// ExchangeNodeGroups. Arcs are defined, connecting ExchangeNodes to each
 /// other. An ExchangeSolver can solve a given instance of an ExchangeGraph, and
 /// the solution is stored on the Graph in the form of Matches.
+///
+/// Solvers operate on the graph's CompactGraph representation (see
+/// compact()). Its per-arc data (preferences and unit capacities) is stored
+/// as arcs are added, either as given to AddArc or, for arcs added without
+/// it, read from their nodes' maps when the representation is built; the
+/// node, group and adjacency indices are built on first use.
 class ExchangeGraph {
  public:
   typedef boost::shared_ptr<ExchangeGraph> Ptr;
@@ -215,9 +336,17 @@ class ExchangeGraph {
   /// @brief adds a supply group to the graph
   void AddSupplyGroup(ExchangeNodeGroup::Ptr prs);
 
-  /// @brief adds an arc to the graph
+  /// @brief adds an arc to the graph, its id is the number of arcs previously
+  /// added. Its preference and unit capacities are read from the maps of its
+  /// nodes (see ExchangeNode::prefs) when compact() is built.
   void AddArc(const Arc& a);
 
+  /// @brief adds an arc with its request node's preference and the unit
+  /// capacities of its request (u) and bid (v) nodes, which are stored in the
+  /// graph's arc arrays rather than in the nodes' maps
+  void AddArc(const Arc& a, double pref, const std::vector<double>& ucaps,
+              const std::vector<double>& vcaps);
+
   /// @brief adds a match for a quanity of flow along an arc
   ///
   /// @param pa the arc corresponding to a match
@@ -227,6 +356,22 @@ class ExchangeGraph {
   /// clears all matches
   inline void ClearMatches() { matches_.clear(); }
 
+  /// @brief returns the index-based representation of the graph, building it
+  /// if any groups or arcs have been added since it was last built. Changes
+  /// made to node preferences or unit capacities after it has been built are
+  /// not reflected.
+  const CompactGraph& compact() const;
+
+  /// @brief splits the graph into its connected components, i.e., sets of
+  /// node groups that are (transitively) connected by arcs. Components share
+  /// the groups, nodes and arcs of this graph, so matches found on a component
+  /// are valid matches of this graph.
+  ///
+  /// @return one graph per component that has arcs, ordered by their first
+  /// arc; groups and arcs keep their relative order within each component.
+  /// Groups without any arcs are not part of any component.
+  std::vector<ExchangeGraph::Ptr> Components() const;
+
   inline const std::vector<RequestGroup::Ptr>& request_groups() const {
     return request_groups_;
   }
@@ -241,36 +386,53 @@ class ExchangeGraph {
     return supply_groups_;
   }
 
-  inline const std::map<ExchangeNode::Ptr, std::vector<Arc>>& node_arc_map()
-      const {
-    return node_arc_map_;
-  }
-  inline std::map<ExchangeNode::Ptr, std::vector<Arc>>& node_arc_map() {
-    return node_arc_map_;
-  }
-
   inline const std::vector<Match>& matches() { return matches_; }
 
   inline const std::vector<Arc>& arcs() const { return arcs_; }
   inline std::vector<Arc>& arcs() { return arcs_; }
 
-  inline const std::map<Arc, int>& arc_ids() const { return arc_ids_; }
-  inline std::map<Arc, int>& arc_ids() { return arc_ids_; }
-
-  inline const std::map<int, Arc>& arc_by_id() const { return arc_by_id_; }
-  inline std::map<int, Arc>& arc_by_id() { return arc_by_id_; }
+  /// @brief node to arc, arc to id and id to arc lookups
+  ///
+  /// @warning these map-based views are kept for backwards compatibility and
+  /// are materialized from arcs() on first use; prefer compact().
+  /// @{
+  const std::map<ExchangeNode::Ptr, std::vector<Arc>>& node_arc_map() const;
+  std::map<ExchangeNode::Ptr, std::vector<Arc>>& node_arc_map();
+  const std::map<Arc, int>& arc_ids() const;
+  std::map<Arc, int>& arc_ids();
+  const std::map<int, Arc>& arc_by_id() const;
+  std::map<int, Arc>& arc_by_id();
+  /// @}
 
  private:
+  void BuildMaps() const;
+  void BuildCompact() const;
+
+  /// adds an arc with ucaps[0, nu) and vcaps[0, nv) as its unit capacities
+  void AddArc(const Arc& a, double pref, const double* ucaps, int nu,
+              const double* vcaps, int nv);
+
   std::vector<RequestGroup::Ptr> request_groups_;
   std::vector<ExchangeNodeGroup::Ptr> supply_groups_;
-  std::map<ExchangeNode::Ptr, std::vector<Arc>> node_arc_map_;
   std::vector<Match> matches_;
   std::vector<Arc> arcs_;
-  std::map<Arc, int> arc_ids_;
-  std::map<int, Arc> arc_by_id_;
-  int next_arc_id_;
+
+  mutable bool maps_dirty_;
+  mutable std::map<ExchangeNode::Ptr, std::vector<Arc>> node_arc_map_;
+  mutable std::map<Arc, int> arc_ids_;
+  mutable std::map<int, Arc> arc_by_id_;
+
+  /// whether each arc's data is read from its nodes' maps
+  std::vector<char> arc_from_nodes_;
+  int n_from_nodes_;
+
+  mutable bool compact_dirty_;
+  mutable CompactGraph compact_;
 };
 
+/// @return the keys of all arcs of a graph, in arc order
+std::vector<ArcKey> ArcKeys(const ExchangeGraph& g);
+
 }  // namespace cyclus
 
 #endif  // CYCLUS_SRC_EXCHANGE_GRAPH_H_
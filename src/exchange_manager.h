@@ -2,6 +2,7 @@
 #define CYCLUS_SRC_EXCHANGE_MANAGER_H_
 
 #include <algorithm>
+#include <chrono>
 
 #include "exchange_graph.h"
 #include "exchange_solver.h"
@@ -13,6 +14,41 @@
 
 namespace cyclus {
 
+/// @brief the wall times (in seconds) of the phases of a single exchange and
+/// the sizes of its graph, see ExchangeManager
+struct ExchangeProfile {
+  ExchangeProfile()
+      : requests(0),
+        bids(0),
+        nodes(0),
+        arcs(0),
+        groups(0),
+        exclusive_arcs(0),
+        trades(0),
+        request_time(0),
+        bid_time(0),
+        pref_time(0),
+        translate_time(0),
+        solve_time(0),
+        back_translate_time(0),
+        trade_time(0) {}
+
+  int requests;
+  int bids;
+  int nodes;
+  int arcs;
+  int groups;
+  int exclusive_arcs;
+  int trades;
+  double request_time;
+  double bid_time;
+  double pref_time;
+  double translate_time;
+  double solve_time;
+  double back_translate_time;
+  double trade_time;
+};
+
 /// @class ExchangeManager
 ///
 /// @brief The ExchangeManager is designed to house all of the internals
@@ -24,6 +60,10 @@ namespace cyclus {
 /// ExchangeManager<ResourceType> manager(ctx);
 /// manager.Execute();
 /// @endcode
+///
+/// If the context's profiler is enabled (see Context::profiler), the wall time
+/// of each phase of the exchange and the size of its graph are recorded in the
+/// ExchangeProfile table.
 template <class T> class ExchangeManager {
  public:
   ExchangeManager(Context* ctx) : ctx_(ctx), debug_(false) {
@@ -32,39 +72,109 @@ template <class T> class ExchangeManager {
 
   /// @brief execute the full resource sequence
   void Execute() {
+    bool profile = ctx_->profiler()->enabled();
+    ExchangeProfile prof;
+    Clock::time_point t = Clock::now();
+
     // collect resource exchange information
     ResourceExchange<T> exchng(ctx_);
     exchng.AddAllRequests();
+    prof.request_time = Lap(&t);
     exchng.AddAllBids();
+    prof.bid_time = Lap(&t);
     exchng.AdjustAll();
+    prof.pref_time = Lap(&t);
     CLOG(LEV_DEBUG1) << "done with info gathering";
 
     if (debug_) RecordDebugInfo(exchng.ex_ctx());
 
-    if (exchng.Empty()) return;  // empty exchange, move on
+    if (exchng.Empty()) {
+      if (profile) RecordProfile(exchng.ex_ctx(), NULL, prof);
+      return;  // empty exchange, move on
+    }
 
     // translate graph
+    t = Clock::now();
     ExchangeTranslator<T> xlator(&exchng.ex_ctx());
     CLOG(LEV_DEBUG1) << "translating graph...";
     ExchangeGraph::Ptr graph = xlator.Translate();
     CLOG(LEV_DEBUG1) << "graph translated!";
+    prof.translate_time = Lap(&t);
 
     // solve graph
     CLOG(LEV_DEBUG1) << "solving graph...";
-    ctx_->solver()->Solve(graph.get());
+    ctx_->solver()->SolveComponents(graph.get());
     CLOG(LEV_DEBUG1) << "graph solved!";
+    prof.solve_time = Lap(&t);
 
     // get trades
     std::vector<Trade<T>> trades;
     xlator.BackTranslateSolution(graph->matches(), trades);
     CLOG(LEV_DEBUG1) << "trades translated!";
+    prof.back_translate_time = Lap(&t);
 
     // execute trades!
     TradeExecutor<T> exec(trades);
     exec.ExecuteTrades(ctx_);
+    prof.trade_time = Lap(&t);
+
+    if (profile) {
+      prof.trades = trades.size();
+      RecordProfile(exchng.ex_ctx(), graph.get(), prof);
+    }
   }
 
  private:
+  typedef std::chrono::steady_clock Clock;
+
+  /// @return the seconds elapsed since t, which is reset to now
+  static double Lap(Clock::time_point* t) {
+    Clock::time_point now = Clock::now();
+    double dt = std::chrono::duration<double>(now - *t).count();
+    *t = now;
+    return dt;
+  }
+
+  /// @brief completes prof with the sizes of the exchange and records it
+  /// @param graph the exchange graph, NULL for empty exchanges
+  void RecordProfile(ExchangeContext<T>& exctx, ExchangeGraph* graph,
+                     ExchangeProfile& prof) {
+    for (int i = 0; i != exctx.requests.size(); ++i) {
+      prof.requests += exctx.requests[i]->requests().size();
+    }
+    for (int i = 0; i != exctx.bids.size(); ++i) {
+      prof.bids += exctx.bids[i]->bids().size();
+    }
+    if (graph != NULL) {
+      const CompactGraph& cg = graph->compact();
+      prof.nodes = cg.n_nodes();
+      prof.arcs = cg.n_arcs();
+      prof.groups = cg.n_groups();
+      for (int a = 0; a != cg.n_arcs(); ++a) {
+        prof.exclusive_arcs += cg.arc_exclusive[a] ? 1 : 0;
+      }
+    }
+
+    ctx_->NewDatum("ExchangeProfile")
+        ->AddVal("Time", ctx_->time())
+        ->AddVal("ResType", T::kType)
+        ->AddVal("Requests", prof.requests)
+        ->AddVal("Bids", prof.bids)
+        ->AddVal("Nodes", prof.nodes)
+        ->AddVal("Arcs", prof.arcs)
+        ->AddVal("Groups", prof.groups)
+        ->AddVal("ExclusiveArcs", prof.exclusive_arcs)
+        ->AddVal("Trades", prof.trades)
+        ->AddVal("RequestTime", prof.request_time)
+        ->AddVal("BidTime", prof.bid_time)
+        ->AddVal("PrefTime", prof.pref_time)
+        ->AddVal("TranslateTime", prof.translate_time)
+        ->AddVal("SolveTime", prof.solve_time)
+        ->AddVal("BackTranslateTime", prof.back_translate_time)
+        ->AddVal("TradeTime", prof.trade_time)
+        ->Record();
+  }
+
   void RecordDebugInfo(ExchangeContext<T>& exctx) {
     typename std::vector<typename RequestPortfolio<T>::Ptr>::iterator it;
     for (it = exctx.requests.begin(); it != exctx.requests.end(); ++it) {
@@ -95,7 +205,7 @@ template <class T> class ExchangeManager {
       for (it4 = bids.begin(); it4 != bids.end(); ++it4) {
         Bid<T>* b = *it4;
         Request<T>* r = b->request();
-        double pref = exctx.trader_prefs[r->requester()][r][b];
+        double pref = exctx.Pref(b);
         std::stringstream ss;
         ss << ctx_->time() << "_" << b->request();
         ctx_->NewDatum("DebugBids")
@@ -1,10 +1,13 @@
 #include "exchange_solver.h"
 
-#include <vector>
+#include <algorithm>
+#include <exception>
 #include <map>
+#include <vector>
 
 #include "context.h"
 #include "exchange_graph.h"
+#include "platform.h"
 
 namespace cyclus {
 
@@ -13,6 +16,93 @@ double ExchangeSolver::Cost(const Arc& a, bool exclusive_orders) {
                                              : 1.0 / a.pref();
 }
 
+ExchangeSolver::~ExchangeSolver() {
+  std::map<std::vector<ArcKey>, ExchangeSolver*>::iterator it;
+  for (it = pool_.begin(); it != pool_.end(); ++it) {
+    delete it->second;
+  }
+}
+
+double ExchangeSolver::SolveComponents(ExchangeGraph* graph) {
+  if (graph != NULL) graph_ = graph;
+  ExchangeGraph* whole = graph_;
+  std::vector<ExchangeGraph::Ptr> comps = whole->Components();
+  if (comps.size() < 2) {
+    return SolveGraph();
+  }
+
+  // each component gets its own solver instance if possible, reusing the one
+  // that solved the same component before
+  int n = comps.size();
+  std::vector<ExchangeSolver*> solvers(n, this);
+  ExchangeSolver* first = Clone();
+  if (first != NULL) {
+    std::map<std::vector<ArcKey>, ExchangeSolver*> pool;
+    for (int i = 0; i < n; ++i) {
+      // a component is identified by all of its arcs; components that look
+      // the same are told apart by their order
+      std::vector<ArcKey> k = ArcKeys(*comps[i]);
+      std::sort(k.begin(), k.end());
+      k.push_back(ArcKey());
+      while (pool.count(k) > 0) {
+        k.back().n++;
+      }
+      std::map<std::vector<ArcKey>, ExchangeSolver*>::iterator it =
+          pool_.find(k);
+      if (it != pool_.end()) {
+        solvers[i] = it->second;
+        pool_.erase(it);
+      } else if (first != NULL) {
+        solvers[i] = first;
+        first = NULL;
+      } else {
+        solvers[i] = Clone();
+      }
+      solvers[i]->sim_ctx(sim_ctx_);
+      if (verbose_) solvers[i]->verbose();
+      solvers[i]->component_ = i;
+      pool[k] = solvers[i];
+    }
+    delete first;
+    std::map<std::vector<ArcKey>, ExchangeSolver*>::iterator it;
+    for (it = pool_.begin(); it != pool_.end(); ++it) {
+      delete it->second;
+    }
+    pool_.swap(pool);
+  }
+
+  std::vector<double> objs(n, 0);
+  std::vector<std::exception_ptr> errors(n);
+#if CYCLUS_IS_PARALLEL
+#pragma omp parallel for schedule(dynamic) if (!pool_.empty())
+#endif
+  for (int i = 0; i < n; ++i) {
+    try {
+      objs[i] = solvers[i]->Solve(comps[i].get());
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  }
+
+  graph_ = whole;
+  for (int i = 0; i < n; ++i) {
+    if (errors[i]) {
+      std::rethrow_exception(errors[i]);
+    }
+  }
+
+  // merge in component order so that the result is deterministic
+  double obj = 0;
+  for (int i = 0; i < n; ++i) {
+    const std::vector<Match>& matches = comps[i]->matches();
+    for (int j = 0; j < matches.size(); ++j) {
+      graph_->AddMatch(matches[j].first, matches[j].second);
+    }
+    obj += objs[i];
+  }
+  return obj;
+}
+
 double ExchangeSolver::PseudoCost() {
   return PseudoCost(1e-1);
 }
@@ -22,57 +112,30 @@ double ExchangeSolver::PseudoCost(double cost_factor) {
 }
 
 double ExchangeSolver::PseudoCostByCap(double cost_factor) {
-  std::vector<ExchangeNode::Ptr>::iterator n_it;
-  std::map<Arc, std::vector<double>>::iterator c_it;
-  std::map<Arc, double>::iterator p_it;
-  std::vector<RequestGroup::Ptr>::iterator rg_it;
-  std::vector<ExchangeNodeGroup::Ptr>::iterator sg_it;
-  double min_cap, pref, coeff;
-
+  const CompactGraph& cg = graph_->compact();
+  const std::vector<Arc>& arcs = graph_->arcs();
   double max_coeff = std::numeric_limits<double>::min();
   double min_unit_cap = std::numeric_limits<double>::max();
-
-  for (sg_it = graph_->supply_groups().begin();
-       sg_it != graph_->supply_groups().end();
-       ++sg_it) {
-    std::vector<ExchangeNode::Ptr>& nodes = (*sg_it)->nodes();
-    for (n_it = nodes.begin(); n_it != nodes.end(); ++n_it) {
-      // update min_unit_cap
-      std::map<Arc, std::vector<double>>::iterator c_it;
-      std::map<Arc, std::vector<double>>& caps = (*n_it)->unit_capacities;
-      for (c_it = caps.begin(); c_it != caps.end(); ++c_it) {
-        std::vector<double>& ucaps = c_it->second;
-        if (!ucaps.empty()) {
-          min_cap = *std::min_element(ucaps.begin(), ucaps.end());
-          if (min_cap < min_unit_cap) min_unit_cap = min_cap;
-        }
+  for (int a = 0; a != cg.n_arcs(); ++a) {
+    int ends[2] = {cg.arc_unode[a], cg.arc_vnode[a]};
+    for (int side = 0; side != 2; ++side) {
+      int g = cg.node_group[ends[side]];
+      if (g < 0) {
+        continue;  // only nodes of the graph's groups count
       }
-    }
-  }
 
-  for (rg_it = graph_->request_groups().begin();
-       rg_it != graph_->request_groups().end();
-       ++rg_it) {
-    std::vector<ExchangeNode::Ptr>& nodes = (*rg_it)->nodes();
-    for (n_it = nodes.begin(); n_it != nodes.end(); ++n_it) {
       // update min_unit_cap
-      std::map<Arc, std::vector<double>>::iterator c_it;
-      std::map<Arc, std::vector<double>>& caps = (*n_it)->unit_capacities;
-      for (c_it = caps.begin(); c_it != caps.end(); ++c_it) {
-        std::vector<double>& ucaps = c_it->second;
-        if (!ucaps.empty()) {
-          min_cap = *std::min_element(ucaps.begin(), ucaps.end());
-          if (min_cap < min_unit_cap) min_unit_cap = min_cap;
-        }
+      const std::vector<int>& start = side == 0 ? cg.ucap_start : cg.vcap_start;
+      const std::vector<double>& caps = side == 0 ? cg.ucaps : cg.vcaps;
+      if (start[a] != start[a + 1]) {
+        min_unit_cap = std::min(
+            min_unit_cap, *std::min_element(caps.begin() + start[a],
+                                            caps.begin() + start[a + 1]));
       }
 
-      // update max_pref_
-      std::map<Arc, double>& prefs = (*n_it)->prefs;
-      for (p_it = prefs.begin(); p_it != prefs.end(); ++p_it) {
-        pref = p_it->second;
-        const Arc& a = p_it->first;
-        coeff = ArcCost(a);
-        if (coeff > max_coeff) max_coeff = coeff;
+      // update max_pref_, for the arcs of request nodes
+      if (side == 0 && g < cg.n_request_groups) {
+        max_coeff = std::max(max_coeff, ArcCost(arcs[a]));
       }
     }
   }
@@ -2,12 +2,14 @@
 #define CYCLUS_SRC_EXCHANGE_SOLVER_H_
 
 #include <cstddef>
+#include <map>
+#include <vector>
+
+#include "exchange_graph.h"
 
 namespace cyclus {
 
 class Context;
-class ExchangeGraph;
-class Arc;
 
 /// @class ExchangeSolver
 ///
@@ -21,8 +23,11 @@ class ExchangeSolver {
   static double Cost(const Arc& a, bool exclusive_orders = kDefaultExclusive);
 
   explicit ExchangeSolver(bool exclusive_orders = kDefaultExclusive)
-      : exclusive_orders_(exclusive_orders), sim_ctx_(NULL), verbose_(false) {}
-  virtual ~ExchangeSolver() {}
+      : exclusive_orders_(exclusive_orders),
+        sim_ctx_(NULL),
+        verbose_(false),
+        component_(-1) {}
+  virtual ~ExchangeSolver();
 
   /// simulation context get/set
   /// @{
@@ -42,6 +47,26 @@ class ExchangeSolver {
     return this->SolveGraph();
   }
 
+  /// @brief solves each connected component of a graph (see
+  /// ExchangeGraph::Components) as an independent subproblem and merges their
+  /// matches into the graph in component order. Components are solved
+  /// concurrently if Cyclus was built with OpenMP and the solver can be
+  /// cloned; results do not depend on the number of threads. The clone that
+  /// solves a component is kept, keyed by the component's arcs (see ArcKeys),
+  /// and reused for the same component in the next call, so solvers with
+  /// persistent state (e.g., ProgSolver's solver interface) keep it across
+  /// time steps. Clones not used in a call with several components are
+  /// discarded.
+  /// @param a pointer to the graph to be solved
+  /// @return the sum of the components' objective values
+  double SolveComponents(ExchangeGraph* graph = NULL);
+
+  /// @brief creates a new solver with the same configuration as this one,
+  /// which is used to solve independent subproblems concurrently. The caller
+  /// owns the returned solver.
+  /// @return the new solver or NULL if the solver does not support cloning
+  virtual ExchangeSolver* Clone() const { return NULL; }
+
   /// @brief Calculates the ratio of the maximum objective coefficient to
   /// minimum unit capacity plus an added cost. This is guaranteed to be larger
   /// than any other arc cost measure and can be used as a cost for unmet
@@ -58,6 +83,10 @@ class ExchangeSolver {
   /// return the cost of an arc
   inline double ArcCost(const Arc& a) { return Cost(a, exclusive_orders_); }
 
+  /// @return the index of the component this solver last solved in
+  /// SolveComponents, or -1 if it solved a whole graph
+  inline int component() const { return component_; }
+
  protected:
   /// @brief Worker function for solving a graph. This must be implemented by
   /// any solver.
@@ -66,6 +95,12 @@ class ExchangeSolver {
   bool exclusive_orders_;
   bool verbose_;
   Context* sim_ctx_;
+  int component_;
+
+ private:
+  /// the clones solving each component, keyed by its sorted arc keys and
+  /// a trailing key that tells apart components with the same arcs
+  std::map<std::vector<ArcKey>, ExchangeSolver*> pool_;
 };
 
 }  // namespace cyclus
@@ -2,6 +2,10 @@
 #define CYCLUS_SRC_EXCHANGE_TRANSLATION_CONTEXT_H_
 
 #include <map>
+#include <utility>
+#include <vector>
+
+#include <boost/shared_ptr.hpp>
 
 #include "bid.h"
 #include "exchange_graph.h"
@@ -9,6 +13,8 @@
 
 namespace cyclus {
 
+template <class T> struct Converter;
+
 /// @class ExchangeTranslationContext
 ///
 /// @brief An ExchangeTranslationContext is a simple holder class for any
@@ -20,6 +26,17 @@ template <class T> struct ExchangeTranslationContext {
   std::map<ExchangeNode::Ptr, Request<T>*> node_to_request;
   std::map<Bid<T>*, ExchangeNode::Ptr> bid_to_node;
   std::map<ExchangeNode::Ptr, Bid<T>*> node_to_bid;
+
+  /// @brief memoized conversions, see Converter::memoizable and
+  /// UnitCapacity()
+  /// @{
+  /// the index of each converter in distinct_converters
+  mutable std::map<const Converter<T>*, int> converter_index;
+  /// converters that are pairwise distinct by Converter::operator==
+  mutable std::vector<boost::shared_ptr<Converter<T>>> distinct_converters;
+  /// unit capacities by converter index and resource quality
+  mutable std::map<std::pair<int, int>, double> unit_capacities;
+  /// @}
 };
 
 }  // namespace cyclus
@@ -1,7 +1,9 @@
 #ifndef CYCLUS_SRC_EXCHANGE_TRANSLATOR_H_
 #define CYCLUS_SRC_EXCHANGE_TRANSLATOR_H_
 
+#include <map>
 #include <sstream>
+#include <utility>
 
 #include "bid.h"
 #include "bid_portfolio.h"
@@ -36,7 +38,9 @@ template <class T> class ExchangeTranslator {
   /// @param ex_ctx the exchance context
   ExchangeTranslator(ExchangeContext<T>* ex_ctx) { ex_ctx_ = ex_ctx; }
 
-  /// @brief translate the ExchangeContext into an ExchangeGraph
+  /// @brief translate the ExchangeContext into an ExchangeGraph. Arc data is
+  /// stored in the graph's arc arrays (see ExchangeGraph::compact()) rather
+  /// than in the nodes' maps.
   ExchangeGraph::Ptr Translate() {
     ExchangeGraph::Ptr graph(new ExchangeGraph());
 
@@ -76,7 +80,7 @@ template <class T> class ExchangeTranslator {
   /// @brief adds a bid-request arc to a graph, if the preference for the arc is
   /// non-negative
   void AddArc(Request<T>* req, Bid<T>* bid, ExchangeGraph::Ptr graph) {
-    double pref = ex_ctx_->trader_prefs.at(req->requester())[req][bid];
+    double pref = ex_ctx_->Pref(bid);
     // TODO: make the following check `pref <=0` and remove the `else if` block
     // before release 1.5
     if (pref < 0) {
@@ -90,16 +94,16 @@ template <class T> class ExchangeTranslator {
       throw ValueError(ss.str());
     }
     // get translated arc
-    Arc a = TranslateArc(xlation_ctx_, bid, pref);
-    a.unode()->prefs[a] = pref;  // request node is a.unode()
-    int n_prefs = a.unode()->prefs.size();
+    ucaps_.clear();
+    vcaps_.clear();
+    Arc a = TranslateArc(xlation_ctx_, bid, pref, &ucaps_, &vcaps_);
 
     CLOG(LEV_DEBUG5) << "Updating preference for one of "
                      << req->requester()->manager()->prototype()
                      << "'s trade nodes:";
-    CLOG(LEV_DEBUG5) << "   preference: " << a.unode()->prefs[a];
+    CLOG(LEV_DEBUG5) << "   preference: " << pref;
 
-    graph->AddArc(a);
+    graph->AddArc(a, pref, ucaps_, vcaps_);
   }
 
   /// @brief Provide a vector of Trades given a vector of Matches
@@ -122,6 +126,9 @@ template <class T> class ExchangeTranslator {
  private:
   ExchangeContext<T>* ex_ctx_;
   ExchangeTranslationContext<T> xlation_ctx_;
+  /// scratch space for the unit capacities of each arc
+  std::vector<double> ucaps_;
+  std::vector<double> vcaps_;
 };
 
 /// @brief Adds a request-node mapping
@@ -223,9 +230,13 @@ Arc TranslateArc(const ExchangeTranslationContext<T>& translation_ctx,
   return TranslateArc<T>(translation_ctx, bid, 1);
 }
 
+/// @brief translates an arc given a bid, appending the unit capacities of its
+/// request node to ucaps and those of its bid node to vcaps rather than
+/// storing them in the nodes (see ExchangeGraph::AddArc)
 template <class T>
 Arc TranslateArc(const ExchangeTranslationContext<T>& translation_ctx,
-                 Bid<T>* bid, double pref) {
+                 Bid<T>* bid, double pref, std::vector<double>* ucaps,
+                 std::vector<double>* vcaps) {
   Request<T>* req = bid->request();
   ExchangeNode::Ptr unode = translation_ctx.request_to_node.at(req);
   ExchangeNode::Ptr vnode = translation_ctx.bid_to_node.at(bid);
@@ -237,10 +248,25 @@ Arc TranslateArc(const ExchangeTranslationContext<T>& translation_ctx,
   typename RequestPortfolio<T>::Ptr rp = req->portfolio();
 
   // bid is v
-  TranslateCapacities(offer, bp->constraints(), vnode, arc, translation_ctx);
+  TranslateCapacities(offer, bp->constraints(), arc, translation_ctx, vcaps);
   // req is u
-  TranslateCapacities(offer, rp->constraints(), unode, arc, translation_ctx);
+  TranslateCapacities(offer, rp->constraints(), arc, translation_ctx, ucaps);
+
+  return arc;
+}
 
+/// @brief translates an arc with the given preference, and also updates the
+/// unit capacities for the associated nodes on the arc
+template <class T>
+Arc TranslateArc(const ExchangeTranslationContext<T>& translation_ctx,
+                 Bid<T>* bid, double pref) {
+  std::vector<double> ucaps;
+  std::vector<double> vcaps;
+  Arc arc = TranslateArc(translation_ctx, bid, pref, &ucaps, &vcaps);
+  std::vector<double>& u = arc.unode()->unit_capacities[arc];
+  u.insert(u.end(), ucaps.begin(), ucaps.end());
+  std::vector<double>& v = arc.vnode()->unit_capacities[arc];
+  v.insert(v.end(), vcaps.begin(), vcaps.end());
   return arc;
 }
 
@@ -258,6 +284,62 @@ Trade<T> BackTranslateMatch(
   return t;
 }
 
+/// @brief the unit capacity of an offer for a constraint, i.e., its converted
+/// quantity per unit quantity
+///
+/// Unit capacities of memoizable converters (see Converter::memoizable) are
+/// computed once per distinct converter and resource quality and cached in
+/// the translation context.
+template <typename T>
+double UnitCapacity(typename T::Ptr offer, const CapacityConstraint<T>& c,
+                    const Arc& a, const ExchangeTranslationContext<T>& ctx) {
+  typename Converter<T>::Ptr conv = c.converter();
+  double qty = offer->quantity();
+  if (!conv->memoizable() || qty <= 0) {
+    return c.convert(offer, &a, &ctx) / qty;
+  }
+
+  // identify the converter, comparing each new one against the known ones
+  typename std::map<const Converter<T>*, int>::iterator c_it =
+      ctx.converter_index.find(conv.get());
+  if (c_it == ctx.converter_index.end()) {
+    int idx = 0;
+    while (idx != ctx.distinct_converters.size() &&
+           !(*ctx.distinct_converters[idx] == *conv)) {
+      ++idx;
+    }
+    if (idx == ctx.distinct_converters.size()) {
+      ctx.distinct_converters.push_back(conv);
+    }
+    c_it = ctx.converter_index.insert(std::make_pair(conv.get(), idx)).first;
+  }
+
+  std::pair<int, int> key(c_it->second, offer->qual_id());
+  std::map<std::pair<int, int>, double>::iterator u_it =
+      ctx.unit_capacities.find(key);
+  if (u_it == ctx.unit_capacities.end()) {
+    double ucap = c.convert(offer, &a, &ctx) / qty;
+    u_it = ctx.unit_capacities.insert(std::make_pair(key, ucap)).first;
+  }
+  return u_it->second;
+}
+
+/// @brief appends the unit capacities of an arc given, a target resource and
+/// constraints, to ucaps
+template <typename T>
+void TranslateCapacities(typename T::Ptr offer,
+                         const typename std::set<CapacityConstraint<T>>& constr,
+                         const Arc& a,
+                         const ExchangeTranslationContext<T>& ctx,
+                         std::vector<double>* ucaps) {
+  typename std::set<CapacityConstraint<T>>::const_iterator it;
+  for (it = constr.begin(); it != constr.end(); ++it) {
+    double ucap = UnitCapacity(offer, *it, a, ctx);
+    CLOG(cyclus::LEV_DEBUG1) << "Additing unit capacity: " << ucap;
+    ucaps->push_back(ucap);
+  }
+}
+
 /// @brief updates a node's unit capacities given, a target resource and
 /// constraints
 template <typename T>
@@ -266,14 +348,7 @@ void TranslateCapacities(typename T::Ptr offer,
                          ExchangeNode::Ptr n,
                          const Arc& a,
                          const ExchangeTranslationContext<T>& ctx) {
-  typename std::set<CapacityConstraint<T>>::const_iterator it;
-  for (it = constr.begin(); it != constr.end(); ++it) {
-    CLOG(cyclus::LEV_DEBUG1)
-        << "Additing unit capacity: "
-        << it->convert(offer, &a, &ctx) / offer->quantity();
-    n->unit_capacities[a].push_back(it->convert(offer, &a, &ctx) /
-                                    offer->quantity());
-  }
+  TranslateCapacities(offer, constr, a, ctx, &n->unit_capacities[a]);
 }
 
 }  // namespace cyclus
@@ -26,6 +26,22 @@ double AvgPref(ExchangeNode::Ptr n) {
              : 0;
 }
 
+double AvgPref(const CompactGraph& cg, int n) {
+  if (n < 0) {
+    return 0;
+  }
+  double sum = 0;
+  int count = 0;
+  for (int k = cg.adj_start[n]; k != cg.adj_start[n + 1]; ++k) {
+    int a = cg.adj_arcs[k];
+    if (cg.arc_unode[a] == n) {
+      sum += cg.arc_pref[a];
+      count++;
+    }
+  }
+  return count > 0 ? sum / count : 0;
+}
+
 GreedyPreconditioner::GreedyPreconditioner(){};
 
 GreedyPreconditioner::GreedyPreconditioner(
@@ -43,6 +59,8 @@ GreedyPreconditioner::GreedyPreconditioner(
 void GreedyPreconditioner::Condition(ExchangeGraph* graph) {
   avg_prefs_.clear();
 
+  // reordering groups and nodes leaves the compact graph's ids valid
+  const CompactGraph& cg = graph->compact();
   std::vector<RequestGroup::Ptr>& groups =
       const_cast<std::vector<RequestGroup::Ptr>&>(graph->request_groups());
 
@@ -53,7 +71,7 @@ void GreedyPreconditioner::Condition(ExchangeGraph* graph) {
 
     // get avg prefs
     for (int i = 0; i != nodes.size(); i++) {
-      avg_prefs_[nodes[i]] = AvgPref(nodes[i]);
+      avg_prefs_[nodes[i]] = AvgPref(cg, cg.node_id(nodes[i].get()));
     }
 
     // sort nodes by weight
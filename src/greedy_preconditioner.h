@@ -18,9 +18,13 @@ double GroupWeight(RequestGroup::Ptr g,
                    std::map<std::string, double>* weights,
                    std::map<ExchangeNode::Ptr, double>* avg_prefs);
 
-/// @returns the average preference across arcs for a node
+/// @returns the average preference across arcs for a node, from its prefs
 double AvgPref(ExchangeNode::Ptr n);
 
+/// @returns the average preference across the arcs of node n (by id) for
+/// which it is the request node, or 0 if n < 0
+double AvgPref(const CompactGraph& cg, int n);
+
 /// @class GreedyPreconditioner
 ///
 /// @brief A GreedyPreconditioner conditions an ExchangeGraph for a GreedySolver
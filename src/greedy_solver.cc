@@ -17,17 +17,17 @@ void Capacity(boost::shared_ptr<cyclus::ExchangeNode>, cyclus::Arc const&,
               double) {};
 
 GreedySolver::GreedySolver(bool exclusive_orders, GreedyPreconditioner* c)
-    : conditioner_(c), ExchangeSolver(exclusive_orders) {}
+    : conditioner_(c), cg_(NULL), ExchangeSolver(exclusive_orders) {}
 
 GreedySolver::GreedySolver(bool exclusive_orders)
-    : ExchangeSolver(exclusive_orders) {
+    : cg_(NULL), ExchangeSolver(exclusive_orders) {
   conditioner_ = new cyclus::GreedyPreconditioner();
 }
 
 GreedySolver::GreedySolver(GreedyPreconditioner* c)
-    : conditioner_(c), ExchangeSolver(true) {}
+    : conditioner_(c), cg_(NULL), ExchangeSolver(true) {}
 
-GreedySolver::GreedySolver() : ExchangeSolver(true) {
+GreedySolver::GreedySolver() : cg_(NULL), ExchangeSolver(true) {
   conditioner_ = new cyclus::GreedyPreconditioner();
 }
 
@@ -35,18 +35,21 @@ GreedySolver::~GreedySolver() {
   if (conditioner_ != NULL) delete conditioner_;
 }
 
+ExchangeSolver* GreedySolver::Clone() const {
+  GreedyPreconditioner* c = NULL;
+  if (conditioner_ != NULL) c = new GreedyPreconditioner(*conditioner_);
+  return new GreedySolver(exclusive_orders_, c);
+}
+
 void GreedySolver::Condition() {
   if (conditioner_ != NULL) conditioner_->Condition(graph_);
 }
 
 void GreedySolver::Init() {
-  std::for_each(graph_->request_groups().begin(),
-                graph_->request_groups().end(),
-                std::bind(&GreedySolver::GetCaps, this, std::placeholders::_1));
-
-  std::for_each(graph_->supply_groups().begin(),
-                graph_->supply_groups().end(),
-                std::bind(&GreedySolver::GetCaps, this, std::placeholders::_1));
+  cg_ = &graph_->compact();
+  n_qty_.assign(cg_->n_nodes(), 0);
+  grp_caps_ = cg_->group_caps;
+  SortArcs();
 }
 
 double GreedySolver::SolveGraph() {
@@ -54,7 +57,6 @@ double GreedySolver::SolveGraph() {
   Condition();
   obj_ = 0;
   unmatched_ = 0;
-  n_qty_.clear();
 
   Init();
 
@@ -89,16 +91,69 @@ double GreedySolver::Capacity(ExchangeNode::Ptr n, const Arc& a, bool min_cap,
         "An notion of node capacity requires a nodegroup.");
   }
 
-  if (n->unit_capacities[a].size() == 0) {
+  // the unit capacities are read from the graph's compact representation
+  if (cg_ == NULL) {
+    throw cyclus::StateError("GreedySolver::Init must be called first.");
+  }
+  const CompactGraph& cg = *cg_;
+  int arc = cg.arc_id(cg.node_id(a.unode().get()), cg.node_id(a.vnode().get()));
+  bool u = n == a.unode();
+  const std::vector<int>& start = u ? cg.ucap_start : cg.vcap_start;
+  int ncaps = arc < 0 ? 0 : start[arc + 1] - start[arc];
+  if (ncaps == 0) {
     return n->qty - curr_qty;
   }
 
-  std::vector<double>& unit_caps = n->unit_capacities[a];
-  const std::vector<double>& group_caps = grp_caps_[n->group];
-  std::vector<double> caps;
+  int g = cg.group_id(n->group);
+  if (g < 0) {
+    throw cyclus::StateError(
+        "A node's group must be part of the graph being solved.");
+  }
+  const std::vector<double>& caps = u ? cg.ucaps : cg.vcaps;
+  return NodeCapacity(g, n->qty, caps.data() + start[arc], ncaps, min_cap,
+                      curr_qty);
+}
+
+double GreedySolver::ArcCapacity(int a, double u_curr_qty,
+                                 double v_curr_qty) {
+  const CompactGraph& cg = *cg_;
+  int u = cg.arc_unode[a];
+  int v = cg.arc_vnode[a];
+  if (cg.node_group[u] < 0 || cg.node_group[v] < 0) {
+    throw cyclus::StateError(
+        "An notion of node capacity requires a nodegroup.");
+  }
+
+  bool min = true;
+  int ustart = cg.ucap_start[a];
+  int vstart = cg.vcap_start[a];
+  double ucap = NodeCapacity(cg.node_group[u], cg.node_qty[u],
+                             cg.ucaps.data() + ustart,
+                             cg.ucap_start[a + 1] - ustart, !min, u_curr_qty);
+  double vcap = NodeCapacity(cg.node_group[v], cg.node_qty[v],
+                             cg.vcaps.data() + vstart,
+                             cg.vcap_start[a + 1] - vstart, min, v_curr_qty);
+
+  CLOG(cyclus::LEV_DEBUG1) << "Capacity for unode of arc: " << ucap;
+  CLOG(cyclus::LEV_DEBUG1) << "Capacity for vnode of arc: " << vcap;
+  CLOG(cyclus::LEV_DEBUG1) << "Capacity for arc         : "
+                           << std::min(ucap, vcap);
+
+  return std::min(ucap, vcap);
+}
+
+double GreedySolver::NodeCapacity(int g, double qty, const double* unit_caps,
+                                  int ncaps, bool min_cap, double curr_qty) {
+  if (ncaps == 0) {
+    return qty - curr_qty;
+  }
+
+  const double* group_caps = grp_caps_.data() + cg_->group_cap_start[g];
   double grp_cap, u_cap, cap;
+  double ret = min_cap ? std::numeric_limits<double>::max()
+                       : -std::numeric_limits<double>::max();
 
-  for (int i = 0; i < unit_caps.size(); i++) {
+  for (int i = 0; i < ncaps; i++) {
     grp_cap = group_caps[i];
     u_cap = unit_caps[i];
     cap = grp_cap / u_cap;
@@ -109,64 +164,119 @@ double GreedySolver::Capacity(ExchangeNode::Ptr n, const Arc& a, bool min_cap,
 
     // special case for unlimited capacities
     if (grp_cap == std::numeric_limits<double>::max()) {
-      caps.push_back(std::numeric_limits<double>::max());
-    } else {
-      caps.push_back(cap);
+      cap = std::numeric_limits<double>::max();
+    }
+
+    if (min_cap) {  // the smallest value is constraining (for bids)
+      ret = std::min(ret, cap);
+    } else {  // the largest value must be met (for requests)
+      ret = std::max(ret, cap);
     }
   }
 
-  if (min_cap) {  // the smallest value is constraining (for bids)
-    cap = *std::min_element(caps.begin(), caps.end());
-  } else {  // the largest value must be met (for requests)
-    cap = *std::max_element(caps.begin(), caps.end());
+  return std::min(ret, qty - curr_qty);
+}
+
+namespace {
+
+/// orders arc ids by precomputed ReqPrefComp keys
+struct ArcKeyComp {
+  explicit ArcKeyComp(const std::vector<GreedySolver::PrefKey>& keys)
+      : keys(keys) {}
+
+  bool operator()(int l, int r) const { return keys[l] < keys[r]; }
+
+  const std::vector<GreedySolver::PrefKey>& keys;
+};
+
+/// orders (key, position) pairs by key only
+struct NodeKeyComp {
+  bool operator()(const std::pair<GreedySolver::PrefKey, int>& l,
+                  const std::pair<GreedySolver::PrefKey, int>& r) const {
+    return l.first < r.first;
+  }
+};
+
+}  // namespace
+
+void GreedySolver::SortArcs() {
+  const CompactGraph& cg = *cg_;
+  int narcs = cg.n_arcs();
+  arc_keys_.resize(narcs);
+  arc_order_.resize(narcs);
+  for (int a = 0; a != narcs; ++a) {
+    PrefKey& k = arc_keys_[a];
+    k.pref = cg.arc_pref[a];
+    k.uid = cg.nodes[cg.arc_unode[a]]->agent_id;
+    k.vid = cg.nodes[cg.arc_vnode[a]]->agent_id;
+    arc_order_[a] = a;
+  }
+  std::stable_sort(arc_order_.begin(), arc_order_.end(),
+                   ArcKeyComp(arc_keys_));
+
+  // adjacency lists are in arc id order, so distributing the globally sorted
+  // arcs over them yields each node's arcs stably sorted by preference
+  sorted_arcs_.resize(cg.adj_arcs.size());
+  fill_.assign(cg.adj_start.begin(), cg.adj_start.end() - 1);
+  for (int i = 0; i != narcs; ++i) {
+    int a = arc_order_[i];
+    sorted_arcs_[fill_[cg.arc_unode[a]]++] = a;
+    sorted_arcs_[fill_[cg.arc_vnode[a]]++] = a;
   }
-  return std::min(cap, n->qty - curr_qty);
 }
 
-void GreedySolver::GetCaps(ExchangeNodeGroup::Ptr g) {
-  for (int i = 0; i != g->nodes().size(); i++) {
-    n_qty_[g->nodes()[i]] = 0;
+void GreedySolver::SortNodes(std::vector<ExchangeNode::Ptr>& nodes) {
+  // average preferences are computed once per node rather than per comparison
+  node_keys_.resize(nodes.size());
+  for (int i = 0; i != nodes.size(); ++i) {
+    PrefKey& k = node_keys_[i].first;
+    k.pref = AvgPref(*cg_, cg_->node_id(nodes[i].get()));
+    k.uid = nodes[i]->agent_id;
+    k.vid = 0;
+    node_keys_[i].second = i;
   }
-  grp_caps_[g.get()] = g->capacities();
+  std::stable_sort(node_keys_.begin(), node_keys_.end(), NodeKeyComp());
+
+  sorted_nodes_.resize(nodes.size());
+  for (int i = 0; i != nodes.size(); ++i) {
+    sorted_nodes_[i].swap(nodes[node_keys_[i].second]);
+  }
+  nodes.swap(sorted_nodes_);
 }
 
 void GreedySolver::GreedilySatisfySet(RequestGroup::Ptr prs) {
+  const CompactGraph& cg = *cg_;
   std::vector<ExchangeNode::Ptr>& nodes = prs->nodes();
-  std::stable_sort(nodes.begin(), nodes.end(), AvgPrefComp);
+  SortNodes(nodes);
 
   std::vector<ExchangeNode::Ptr>::iterator req_it = nodes.begin();
   double target = prs->qty();
   double match = 0;
 
-  ExchangeNode::Ptr u, v;
-  std::vector<Arc>::const_iterator arc_it;
-  std::vector<Arc> sorted;
+  int a, u, v;
   double remain, tomatch, excl_val;
 
   CLOG(LEV_DEBUG1) << "Greedy Solving for " << target
                    << " amount of a resource.";
 
   while ((match <= target) && (req_it != nodes.end())) {
-    // this if statement is needed because map.at() will throw if the key does
-    // not exist, which is a corner case for when there is a request with no bid
-    // arcs associated with it
-    if (graph_->node_arc_map().count(*req_it) > 0) {
-      const std::vector<Arc>& arcs = graph_->node_arc_map().at(*req_it);
-      sorted = std::vector<Arc>(arcs);  // make a copy for now
-      std::stable_sort(sorted.begin(), sorted.end(), ReqPrefComp);
-      arc_it = sorted.begin();
-
-      while ((match <= target) && (arc_it != sorted.end())) {
+    int n = cg.node_id(req_it->get());
+    // a request node may have no bid arcs associated with it
+    if (n >= 0 && cg.adj_start[n] != cg.adj_start[n + 1]) {
+      const int* arc_it = sorted_arcs_.data() + cg.adj_start[n];
+      const int* arc_end = sorted_arcs_.data() + cg.adj_start[n + 1];
+
+      while ((match <= target) && (arc_it != arc_end)) {
         remain = target - match;
-        const Arc& a = *arc_it;
-        u = a.unode();
-        v = a.vnode();
+        a = *arc_it;
+        u = cg.arc_unode[a];
+        v = cg.arc_vnode[a];
         // capacity adjustment
-        tomatch = std::min(remain, Capacity(a, n_qty_[u], n_qty_[v]));
+        tomatch = std::min(remain, ArcCapacity(a, n_qty_[u], n_qty_[v]));
 
         // exclusivity adjustment
-        if (arc_it->exclusive()) {
-          excl_val = a.excl_val();
+        if (cg.arc_exclusive[a]) {
+          excl_val = cg.arc_excl_val[a];
 
           // this careful float comparison is vital for preventing false
           // positive constraint violations w.r.t. exclusivity-related capacity.
@@ -181,18 +291,18 @@ void GreedySolver::GreedilySatisfySet(RequestGroup::Ptr prs) {
         if (tomatch > eps()) {
           CLOG(LEV_DEBUG1) << "Greedy Solver is matching " << tomatch
                            << " amount of a resource.";
-          UpdateCapacity(u, a, tomatch);
-          UpdateCapacity(v, a, tomatch);
+          UpdateCapacity(u, cg.ucaps.data() + cg.ucap_start[a], tomatch);
+          UpdateCapacity(v, cg.vcaps.data() + cg.vcap_start[a], tomatch);
           n_qty_[u] += tomatch;
           n_qty_[v] += tomatch;
-          graph_->AddMatch(a, tomatch);
+          graph_->AddMatch(graph_->arcs()[a], tomatch);
 
           match += tomatch;
-          UpdateObj(tomatch, u->prefs[a]);
+          UpdateObj(tomatch, cg.arc_pref[a]);
         }
         ++arc_it;
       }  // while( (match =< target) && (arc_it != arcs.end()) )
-    }  // if(graph_->node_arc_map().count(*req_it) > 0)
+    }  // if(n >= 0 && node has arcs)
     ++req_it;
   }  // while( (match =< target) && (req_it != nodes.end()) )
 
@@ -205,27 +315,31 @@ void GreedySolver::UpdateObj(double qty, double pref) {
   obj_ += qty / pref;
 }
 
-void GreedySolver::UpdateCapacity(ExchangeNode::Ptr n, const Arc& a,
+void GreedySolver::UpdateCapacity(int n, const double* unit_caps,
                                   double qty) {
   using cyclus::IsNegative;
   using cyclus::ValueError;
 
-  std::vector<double>& unit_caps = n->unit_capacities[a];
-  std::vector<double>& caps = grp_caps_[n->group];
-  assert(unit_caps.size() == caps.size());
-  for (int i = 0; i < caps.size(); i++) {
-    double prev = caps[i];
-    // special case for unlimited capacities
-    CLOG(cyclus::LEV_DEBUG1) << "Updating capacity value from: " << prev;
-    caps[i] = (prev == std::numeric_limits<double>::max())
-                  ? std::numeric_limits<double>::max()
-                  : prev - qty * unit_caps[i];
-    CLOG(cyclus::LEV_DEBUG1) << "                          to: " << caps[i];
+  const CompactGraph& cg = *cg_;
+  int g = cg.node_group[n];
+  if (g >= 0) {
+    double* caps = grp_caps_.data() + cg.group_cap_start[g];
+    int ncaps = cg.group_cap_start[g + 1] - cg.group_cap_start[g];
+    for (int i = 0; i < ncaps; i++) {
+      double prev = caps[i];
+      // special case for unlimited capacities
+      CLOG(cyclus::LEV_DEBUG1) << "Updating capacity value from: " << prev;
+      caps[i] = (prev == std::numeric_limits<double>::max())
+                    ? std::numeric_limits<double>::max()
+                    : prev - qty * unit_caps[i];
+      CLOG(cyclus::LEV_DEBUG1) << "                          to: " << caps[i];
+    }
   }
 
-  if (IsNegative(n->qty - qty)) {
+  const ExchangeNode* node = cg.nodes[n];
+  if (IsNegative(node->qty - qty)) {
     std::stringstream ss;
-    ss << "A bid for " << n->commod << " was set at " << n->qty
+    ss << "A bid for " << node->commod << " was set at " << node->qty
        << " but has been matched to a higher value " << qty
        << ". This could be due to a problem with your "
        << "bid portfolio constraints.";
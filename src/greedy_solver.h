@@ -1,6 +1,9 @@
 #ifndef CYCLUS_SRC_GREEDY_SOLVER_H_
 #define CYCLUS_SRC_GREEDY_SOLVER_H_
 
+#include <utility>
+#include <vector>
+
 #include <boost/shared_ptr.hpp>
 #include "exchange_graph.h"
 #include "exchange_solver.h"
@@ -78,6 +81,9 @@ class GreedySolver : public ExchangeSolver {
 
   virtual ~GreedySolver();
 
+  /// @return a new GreedySolver with a copy of this solver's conditioner
+  virtual ExchangeSolver* Clone() const;
+
   /// Uses the provided (or a default) GreedyPreconditioner to condition the
   /// solver's ExchangeGraph so that RequestGroups are ordered by average
   /// preference and commodity weight.
@@ -106,7 +112,8 @@ class GreedySolver : public ExchangeSolver {
 
   /// @brief the capacity of a node
   ///
-  /// @throws StateError if ExchangeNode does not have a ExchangeNodeGroup
+  /// @throws StateError if ExchangeNode does not have a ExchangeNodeGroup or
+  /// Init has not been called
   /// @param n the node
   /// @param min_cap whether to use the minimum or maximum capacity value. In
   /// general, nodes that represent bids use the minimum (i.e., the capacities
@@ -131,6 +138,20 @@ class GreedySolver : public ExchangeSolver {
   }
   /// @}
 
+  /// @brief a precomputed sort key, ordering preferences in descending order
+  /// and ties by descending agent ids (see ReqPrefComp and AvgPrefComp)
+  struct PrefKey {
+    double pref;
+    int uid;
+    int vid;
+
+    inline bool operator<(const PrefKey& other) const {
+      return (pref != other.pref)
+                 ? (pref > other.pref)
+                 : (uid > other.uid || (uid == other.uid && vid > other.vid));
+    }
+  };
+
  protected:
   /// @brief the GreedySolver solves an ExchangeGraph by iterating over each
   /// RequestGroup and matching requests with the minimum bids possible,
@@ -139,22 +160,54 @@ class GreedySolver : public ExchangeSolver {
   virtual double SolveGraph();
 
  private:
-  /// @brief updates the capacity of a given ExchangeNode (i.e., its max_qty and
-  /// the capacities of its ExchangeNodeGroup)
+  /// @brief the capacity of an arc (by id) in the graph's compact
+  /// representation, see Capacity(const Arc&, double, double)
+  double ArcCapacity(int a, double u_curr_qty, double v_curr_qty);
+
+  /// @brief the capacity of a node in group g (by id) with quantity qty given
+  /// its unit capacities along an arc, see Capacity(ExchangeNode::Ptr, const
+  /// Arc&, bool, double)
+  double NodeCapacity(int g, double qty, const double* unit_caps, int ncaps,
+                      bool min_cap, double curr_qty);
+
+  /// @brief updates the capacity of a given ExchangeNode's
+  /// ExchangeNodeGroup
   ///
-  /// @throws StateError if ExchangeNode does not have a ExchangeNodeGroup
-  /// @throws ValueError if the update results in a negative ExchangeNodeGroup
-  /// capacity or a negative ExchangeNode max_qty
-  /// @param n the ExchangeNode
+  /// @throws ValueError if the update results in a negative ExchangeNode
+  /// max_qty
+  /// @param n the ExchangeNode id
+  /// @param unit_caps the node's unit capacities for the matched arc
   /// @param qty the quantity for the node to update
-  void GetCaps(ExchangeNodeGroup::Ptr prs);
+  void UpdateCapacity(int n, const double* unit_caps, double qty);
+
+  /// @brief sorts the arcs of every node in the graph's compact
+  /// representation by preference, once per solve
+  void SortArcs();
+
+  /// @brief stably sorts request nodes by average preference (see
+  /// AvgPrefComp) in place
+  void SortNodes(std::vector<ExchangeNode::Ptr>& nodes);
+
   void GreedilySatisfySet(RequestGroup::Ptr prs);
-  void UpdateCapacity(ExchangeNode::Ptr n, const Arc& a, double qty);
   void UpdateObj(double qty, double pref);
 
   GreedyPreconditioner* conditioner_;
-  std::map<ExchangeNode::Ptr, double> n_qty_;
-  std::map<ExchangeNodeGroup*, std::vector<double>> grp_caps_;
+  const CompactGraph* cg_;
+  /// @brief the quantity matched so far, indexed by node id
+  std::vector<double> n_qty_;
+  /// @brief the remaining group capacities, laid out as
+  /// CompactGraph::group_caps
+  std::vector<double> grp_caps_;
+  /// @brief the sort key of each arc
+  std::vector<PrefKey> arc_keys_;
+  /// @brief the arcs incident on each node, laid out as
+  /// CompactGraph::adj_arcs but sorted by preference
+  std::vector<int> sorted_arcs_;
+  /// @brief scratch space for sorting arcs and nodes
+  std::vector<int> arc_order_;
+  std::vector<int> fill_;
+  std::vector<std::pair<PrefKey, int> > node_keys_;
+  std::vector<ExchangeNode::Ptr> sorted_nodes_;
   double obj_;
   double unmatched_;
 };
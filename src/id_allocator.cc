@@ -0,0 +1,116 @@
+#include "id_allocator.h"
+
+#include <algorithm>
+
+#include "error.h"
+
+namespace cyclus {
+
+int IdAllocator::block_size_ = 64;
+
+PhaseListener::PhaseListener() {
+  ParallelIdPhase::listeners().push_back(this);
+}
+
+PhaseListener::~PhaseListener() {
+  std::vector<PhaseListener*>& all = ParallelIdPhase::listeners();
+  all.erase(std::remove(all.begin(), all.end(), this), all.end());
+}
+
+IdAllocator::IdAllocator(int first) : next_(first), base_(first) {}
+
+IdAllocator::~IdAllocator() {}
+
+int IdAllocator::Next() {
+  int i = ParallelIdPhase::slot_;
+  if (slots_.empty()) {
+    return next_++;
+  } else if (i >= 0) {
+    // only the thread bound to slot i touches slots_[i]
+    return Next(i);
+  }
+
+  // ids drawn outside of the slots share the last block of each level
+  int id;
+#pragma omp critical(cyclus_unslotted_ids)
+  id = Next(slots_.size() - 1);
+  return id;
+}
+
+int IdAllocator::Next(int i) {
+  Slot& s = slots_[i];
+  if (s.next == s.end) {
+    int nblocks = slots_.size();
+    if (s.level < 0) {
+      s.level = base_;
+      s.size = 1;
+    } else {
+      s.level += nblocks * s.size;
+      s.size = std::min(2 * s.size, block_size_);
+    }
+    s.next = s.level + i * s.size;
+    s.end = s.next + s.size;
+  }
+  s.max = s.next;
+  return s.next++;
+}
+
+void IdAllocator::block_size(int n) {
+  if (n < 1) {
+    throw ValueError("id block size must be positive");
+  }
+  block_size_ = n;
+}
+
+void IdAllocator::BeginPhase(int nslots) {
+  base_ = next_;
+  slots_.assign(nslots + 1, Slot());
+}
+
+void IdAllocator::EndPhase() {
+  int max = base_ - 1;
+  for (int i = 0; i < slots_.size(); ++i) {
+    max = std::max(max, slots_[i].max);
+  }
+  slots_.clear();
+  next_ = max + 1;
+}
+
+thread_local int ParallelIdPhase::slot_ = -1;
+int ParallelIdPhase::nslots_ = 0;
+
+ParallelIdPhase::ParallelIdPhase(int nslots) {
+  if (nslots_ > 0) {
+    throw StateError("parallel id phases cannot be nested");
+  }
+  nslots_ = nslots;
+  std::vector<PhaseListener*>& all = listeners();
+  for (int i = 0; i < all.size(); ++i) {
+    all[i]->BeginPhase(nslots);
+  }
+}
+
+ParallelIdPhase::~ParallelIdPhase() {
+  std::vector<PhaseListener*>& all = listeners();
+  for (int i = 0; i < all.size(); ++i) {
+    all[i]->EndPhase();
+  }
+  nslots_ = 0;
+}
+
+void ParallelIdPhase::EnterSlot(int i) {
+  slot_ = i;
+}
+
+void ParallelIdPhase::LeaveSlot() {
+  slot_ = -1;
+}
+
+std::vector<PhaseListener*>& ParallelIdPhase::listeners() {
+  // intentionally leaked so that static allocators can safely unregister
+  // during program exit regardless of destruction order
+  static std::vector<PhaseListener*>* all = new std::vector<PhaseListener*>();
+  return *all;
+}
+
+}  // namespace cyclus
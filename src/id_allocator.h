@@ -0,0 +1,147 @@
+#ifndef CYCLUS_SRC_ID_ALLOCATOR_H_
+#define CYCLUS_SRC_ID_ALLOCATOR_H_
+
+#include <atomic>
+#include <vector>
+
+namespace cyclus {
+
+/// PhaseListener is notified when parallel id phases (see ParallelIdPhase)
+/// open and close, so that it can keep state per slot during the phase, e.g.
+/// ids or recorded output, and settle it in slot order afterwards. Listeners
+/// register themselves on construction.
+class PhaseListener {
+ public:
+  PhaseListener();
+  virtual ~PhaseListener();
+
+  /// Called when a phase with nslots slots opens.
+  virtual void BeginPhase(int nslots) = 0;
+
+  /// Called when the phase closes.
+  virtual void EndPhase() = 0;
+};
+
+/// IdAllocator hands out unique, monotonically increasing integer ids (e.g.
+/// resource state/object ids and composition ids). Outside of a parallel id
+/// phase, ids are drawn from a single atomic counter and are therefore both
+/// thread-safe and identical to a plain serial counter.
+///
+/// Inside a parallel id phase (see ParallelIdPhase), every unit of work (a
+/// "slot", e.g. one agent's Tick) draws its ids from blocks whose position
+/// depends only on the slot index and on how many ids the slot has used, so
+/// the ids do not depend on thread scheduling or the number of threads.
+/// Blocks are laid out in levels after the counter value at the start of
+/// the phase: level 0 holds one id per slot, and each further level holds
+/// one block per slot that is twice as large as in the level before, up to
+/// the block size.  Ids drawn outside of any slot while a phase is open come
+/// from one more block per level, after those of the slots.  When the phase
+/// ends, the shared counter resumes right after the largest id used, so a
+/// phase skips at most about the number of slots times twice the ids of its
+/// busiest slot (or that plus the block size, once blocks are full size).
+class IdAllocator : public PhaseListener {
+ public:
+  /// Creates a new allocator whose first id will be first.
+  explicit IdAllocator(int first = 1);
+
+  ~IdAllocator();
+
+  /// Returns a new unique id.
+  int Next();
+
+  /// Returns the next id that will be handed out by the shared counter.
+  int next() const { return next_; }
+
+  /// Resets the shared counter so that the next id handed out is id. This
+  /// must not be called during a parallel id phase.
+  void Reset(int id) { next_ = id; }
+
+  /// Returns the largest number of ids per block used during parallel id
+  /// phases.
+  static int block_size() { return block_size_; }
+
+  /// Sets the largest number of ids per block used during parallel id
+  /// phases.  Larger blocks mean fewer reservations from the shared counter
+  /// for slots that create many objects.
+  static void block_size(int n);
+
+ private:
+  friend class ParallelIdPhase;
+
+  /// per-slot block bookkeeping for a parallel id phase.
+  struct Slot {
+    Slot() : next(0), end(0), level(-1), size(0), max(-1) {}
+    int next;
+    int end;
+    /// start of the slot's current level
+    int level;
+    /// size of the slot's blocks in the current level
+    int size;
+    int max;
+  };
+
+  /// Draws the next id of slot i, moving the slot on to its block in the
+  /// next level when the current one is used up.
+  int Next(int i);
+
+  virtual void BeginPhase(int nslots);
+  virtual void EndPhase();
+
+  std::atomic<int> next_;
+  int base_;
+  std::vector<Slot> slots_;
+
+  static int block_size_;
+};
+
+/// ParallelIdPhase marks a region (e.g. an OpenMP parallel loop over agents)
+/// during which all IdAllocators hand out ids deterministically by slot and
+/// Recorders buffer the output of each slot.
+/// Each iteration of the loop must call EnterSlot with its (deterministic)
+/// iteration index before creating any objects and LeaveSlot afterwards:
+///
+/// @code
+/// {
+///   ParallelIdPhase phase(agents.size());
+///   #pragma omp parallel for
+///   for (int i = 0; i < agents.size(); ++i) {
+///     ParallelIdPhase::EnterSlot(i);
+///     agents[i]->Tick();
+///     ParallelIdPhase::LeaveSlot();
+///   }
+/// }
+/// @endcode
+///
+/// The phase itself must be opened and closed (constructed and destroyed)
+/// from a single thread and phases may not be nested.
+class ParallelIdPhase {
+ public:
+  /// Opens a parallel id phase with nslots slots.
+  explicit ParallelIdPhase(int nslots);
+
+  /// Closes the phase and advances all shared counters past the ids used.
+  ~ParallelIdPhase();
+
+  /// Binds the calling thread to slot i of the active phase.
+  static void EnterSlot(int i);
+
+  /// Unbinds the calling thread from its slot.
+  static void LeaveSlot();
+
+  /// Returns the slot of the calling thread, or -1 outside of slots and
+  /// phases.
+  static int slot() { return nslots_ > 0 ? slot_ : -1; }
+
+ private:
+  friend class IdAllocator;
+  friend class PhaseListener;
+
+  static std::vector<PhaseListener*>& listeners();
+
+  static thread_local int slot_;
+  static int nslots_;
+};
+
+}  // namespace cyclus
+
+#endif  // CYCLUS_SRC_ID_ALLOCATOR_H_
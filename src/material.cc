@@ -16,13 +16,15 @@ Material::~Material() {}
 
 Material::Ptr Material::Create(Agent* creator, double quantity,
                                Composition::Ptr c, std::string package_name) {
-  Material::Ptr m(new Material(creator->context(), quantity, c, package_name));
+  Material::Ptr m = NewPooledPtr(
+      new Material(creator->context(), quantity, c, package_name));
   m->tracker_.Create(creator);
   return m;
 }
 
 Material::Ptr Material::CreateUntracked(double quantity, Composition::Ptr c) {
-  Material::Ptr m(new Material(NULL, quantity, c, Package::unpackaged_name()));
+  Material::Ptr m = NewPooledPtr(
+      new Material(NULL, quantity, c, Package::unpackaged_name()));
   return m;
 }
 
@@ -36,7 +38,7 @@ const ResourceType Material::type() const {
 
 Resource::Ptr Material::Clone() const {
   Material* m = new Material(*this);
-  Resource::Ptr c(m);
+  Resource::Ptr c = NewPooledPtr(m);
   m->tracker_.DontTrack();
   return c;
 }
@@ -86,7 +88,8 @@ Material::Ptr Material::ExtractComp(double qty, Composition::Ptr c,
   }
 
   qty_ -= qty;
-  Material::Ptr other(new Material(ctx_, qty, c, Package::unpackaged_name()));
+  Material::Ptr other =
+      NewPooledPtr(new Material(ctx_, qty, c, Package::unpackaged_name()));
 
   // Decay called on the extracted material should have the same dt as for
   // this material regardless of composition.
@@ -146,7 +149,8 @@ Resource::Ptr Material::PackageExtract(double qty,
   }
 
   qty_ -= qty;
-  Material::Ptr other(new Material(ctx_, qty, comp_, new_package_name));
+  Material::Ptr other =
+      NewPooledPtr(new Material(ctx_, qty, comp_, new_package_name));
 
   // Decay called on the extracted material should have the same dt as for
   // this material regardless of composition.
@@ -198,55 +202,32 @@ void Material::Decay(int curr_time) {
     return;
   }
 
-  double eps = 1e-3;
-  const CompMap c = comp_->atom();
-
-  // If composition has too many nuclides (i.e. > 100), it is cheaper to
-  // just do the decay rather than check all the decay constants.
-  bool decay = c.size() > 100;
-
   uint64_t secs_per_timestep = kDefaultTimeStepDur;
+  bool link_parent = false;
   if (ctx_ != NULL) {
     secs_per_timestep = ctx_->sim_info().dt;
+    link_parent = ctx_->sim_info().compact_decay_chains;
   }
 
-  if (!decay) {
-    // Only do the decay calc if one of the nuclides would change in number
-    // density more than fraction eps.
-    // i.e. decay if   (1 - eps) > exp(-lambda*dt)
-    CompMap::const_reverse_iterator it;
-    for (it = c.rbegin(); it != c.rend(); ++it) {
-      int nuc = it->first;
-      double lambda_timesteps =
-          pyne::decay_const(nuc) * static_cast<double>(secs_per_timestep);
-      double change =
-          1.0 - std::exp(-lambda_timesteps * static_cast<double>(dt));
-      if (change >= eps) {
-        decay = true;
-        break;
-      }
-    }
-    if (!decay) {
-      return;
-    }
+  // If composition has too many nuclides (i.e. > 100), it is cheaper to
+  // just do the decay rather than check all the decay constants.  Otherwise
+  // only do the decay calc if one of the nuclides would change in number
+  // density more than fraction eps - this check is cached on the composition.
+  if (comp_->atom().size() <= 100 &&
+      comp_->DecayNegligible(dt, secs_per_timestep)) {
+    return;
   }
 
   prev_decay_time_ = curr_time;  // this must go before Transmute call
-  Composition::Ptr decayed = comp_->Decay(dt, secs_per_timestep);
+  Composition::Ptr decayed =
+      comp_->Decay(dt, secs_per_timestep, link_parent);
   Transmute(decayed);
 }
 
 double Material::DecayHeat() {
-  double decay_heat = 0.;
-  // Pyne decay heat operates with grams, cyclus generally in kilograms.
-  pyne::Material p_map = pyne::Material(comp_->mass(), qty_ * 1000);
-  std::map<int, double> dec_heat = p_map.decay_heat();
-  for (auto nuc : dec_heat) {
-    if (!std::isnan(nuc.second)) {
-      decay_heat += nuc.second;
-    }
-  }
-  return decay_heat;
+  // decay heat scales linearly with mass, so the per-kg value cached on the
+  // composition can be reused across all materials sharing it.
+  return comp_->decay_heat() * qty_;
 }
 
 Composition::Ptr Material::comp() const {
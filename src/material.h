@@ -6,6 +6,7 @@
 
 #include "composition.h"
 #include "cyc_limits.h"
+#include "pool_base.h"
 #include "resource.h"
 #include "res_tracker.h"
 
@@ -68,7 +69,7 @@ const double ug = kg * .000000001;
 ///   Material::Ptr mox = bucket.ExtractComp(qty, comp);
 ///   @endcode
 ///
-class Material : public Resource {
+class Material : public Resource, public PoolBase<Material> {
   friend class SimInit;
 
  public:
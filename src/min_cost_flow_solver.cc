@@ -0,0 +1,266 @@
+#include "min_cost_flow_solver.h"
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+
+#include "cyc_limits.h"
+#include "greedy_solver.h"
+#include "logger.h"
+#include "platform.h"
+#if CYCLUS_HAS_COIN
+#include "prog_solver.h"
+#endif
+
+namespace cyclus {
+
+namespace {
+
+const double kInf = std::numeric_limits<double>::infinity();
+
+// the single (uniform) unit capacity coefficient of each group with one
+// capacity constraint, 0 for groups without constraints, or -1 if the group
+// cannot be expressed in a flow network
+std::vector<double> GroupCoeffs(const CompactGraph& cg) {
+  std::vector<double> coeffs(cg.n_groups(), 0);
+  for (int g = 0; g != cg.n_groups(); ++g) {
+    int nrows = cg.group_cap_start[g + 1] - cg.group_cap_start[g];
+    if (nrows > 1) {
+      coeffs[g] = -1;
+    }
+  }
+
+  for (int a = 0; a != cg.n_arcs(); ++a) {
+    for (int side = 0; side != 2; ++side) {
+      int n = side == 0 ? cg.arc_unode[a] : cg.arc_vnode[a];
+      const std::vector<int>& start =
+          side == 0 ? cg.ucap_start : cg.vcap_start;
+      const std::vector<double>& caps = side == 0 ? cg.ucaps : cg.vcaps;
+      int g = cg.node_group[n];
+      if (g < 0 || coeffs[g] < 0) {
+        continue;
+      }
+
+      int nrows = cg.group_cap_start[g + 1] - cg.group_cap_start[g];
+      if (start[a + 1] - start[a] != nrows) {
+        coeffs[g] = -1;
+      } else if (nrows == 1) {
+        double c = caps[start[a]];
+        if (c <= 0 || (coeffs[g] > 0 && c != coeffs[g])) {
+          coeffs[g] = -1;
+        } else {
+          coeffs[g] = c;
+        }
+      }
+    }
+  }
+  return coeffs;
+}
+
+}  // namespace
+
+MinCostFlowSolver::MinCostFlowSolver(bool exclusive_orders)
+    : fallback_(NULL), used_fallback_(false), ExchangeSolver(exclusive_orders) {
+#if CYCLUS_HAS_COIN
+  fallback_ = new ProgSolver("cbc", exclusive_orders);
+#else
+  fallback_ = new GreedySolver(exclusive_orders);
+#endif
+}
+
+MinCostFlowSolver::MinCostFlowSolver(bool exclusive_orders,
+                                     ExchangeSolver* fallback)
+    : fallback_(fallback),
+      used_fallback_(false),
+      ExchangeSolver(exclusive_orders) {
+  if (fallback_ == NULL) {
+#if CYCLUS_HAS_COIN
+    fallback_ = new ProgSolver("cbc", exclusive_orders);
+#else
+    fallback_ = new GreedySolver(exclusive_orders);
+#endif
+  }
+}
+
+MinCostFlowSolver::~MinCostFlowSolver() {
+  if (fallback_ != NULL) delete fallback_;
+}
+
+ExchangeSolver* MinCostFlowSolver::Clone() const {
+  ExchangeSolver* fallback = fallback_->Clone();
+  return fallback == NULL ? NULL
+                          : new MinCostFlowSolver(exclusive_orders_, fallback);
+}
+
+bool MinCostFlowSolver::IsFlowProblem(const ExchangeGraph* g) const {
+  const CompactGraph& cg = g->compact();
+  for (int a = 0; a != cg.n_arcs(); ++a) {
+    if ((exclusive_orders_ && cg.arc_exclusive[a]) || cg.arc_pref[a] <= 0) {
+      return false;
+    }
+
+    int ug = cg.node_group[cg.arc_unode[a]];
+    int vg = cg.node_group[cg.arc_vnode[a]];
+    if (ug < 0 || ug >= cg.n_request_groups || vg < cg.n_request_groups) {
+      return false;
+    }
+  }
+
+  std::vector<double> coeffs = GroupCoeffs(cg);
+  for (int g = 0; g != coeffs.size(); ++g) {
+    if (coeffs[g] < 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+double MinCostFlowSolver::SolveGraph() {
+  used_fallback_ = !IsFlowProblem(graph_);
+  if (used_fallback_) {
+    CLOG(LEV_DEBUG1) << "Exchange graph is not a pure flow problem, "
+                     << "solving it with the fallback solver.";
+    fallback_->sim_ctx(sim_ctx_);
+    return fallback_->Solve(graph_);
+  }
+
+  const CompactGraph& cg = graph_->compact();
+  int nreq = cg.n_request_groups;
+  std::vector<double> coeffs = GroupCoeffs(cg);
+
+  // unmet demand costs more than any arc (see PseudoCostByPref)
+  double max_cost = 0;
+  std::vector<char> has_arcs(nreq, 0);
+  for (int a = 0; a != cg.n_arcs(); ++a) {
+    max_cost = std::max(max_cost, 1.0 / cg.arc_pref[a]);
+    has_arcs[cg.node_group[cg.arc_unode[a]]] = 1;
+  }
+  double pseudo_cost = max_cost * (1 + 1e-1);
+
+  // network nodes: 0 is the source, 1 the sink and 2 + g the node of group g;
+  // flow is the traded quantity, so group capacities are divided by the
+  // group's unit capacity coefficient
+  head_.assign(2 + cg.n_groups(), -1);
+  next_.clear();
+  edges_.clear();
+
+  std::vector<int> arc_edge(cg.n_arcs());
+  for (int a = 0; a != cg.n_arcs(); ++a) {
+    int u = cg.arc_unode[a];
+    int v = cg.arc_vnode[a];
+    double qty = std::min(cg.node_qty[u], cg.node_qty[v]);
+    arc_edge[a] = AddEdge(2 + cg.node_group[v], 2 + cg.node_group[u], qty,
+                          1.0 / cg.arc_pref[a]);
+  }
+
+  for (int g = nreq; g != cg.n_groups(); ++g) {
+    double cap = kInf;
+    if (coeffs[g] > 0) {
+      cap = cg.group_caps[cg.group_cap_start[g]];
+      cap = cap == std::numeric_limits<double>::max() ? kInf : cap / coeffs[g];
+    }
+    AddEdge(0, 2 + g, cap, 0);
+  }
+
+  std::vector<int> faux_edge(nreq, -1);
+  for (int g = 0; g != nreq; ++g) {
+    if (!has_arcs[g] || coeffs[g] == 0) {
+      continue;  // no arcs or constraints, no reason to add edges
+    }
+
+    // 1e15 mirrors the ProgTranslator's bound on requested quantities
+    double demand = std::min(cg.group_caps[cg.group_cap_start[g]], 1e15);
+    AddEdge(2 + g, 1, demand / coeffs[g], 0);
+    faux_edge[g] = AddEdge(0, 2 + g, kInf, pseudo_cost * coeffs[g]);
+  }
+
+  SuccessiveShortestPaths();
+
+  // record matches in arc order, the flow of an arc is its reverse capacity
+  double obj = 0;
+  std::vector<Arc>& arcs = graph_->arcs();
+  for (int a = 0; a != cg.n_arcs(); ++a) {
+    double flow = edges_[arc_edge[a] ^ 1].cap;
+    if (flow > eps()) {
+      graph_->AddMatch(arcs[a], flow);
+      obj += flow / cg.arc_pref[a];
+    }
+  }
+  for (int g = 0; g != nreq; ++g) {
+    if (faux_edge[g] >= 0) {
+      obj += edges_[faux_edge[g] ^ 1].cap * edges_[faux_edge[g]].cost;
+    }
+  }
+  return obj;
+}
+
+int MinCostFlowSolver::AddEdge(int from, int to, double cap, double cost) {
+  Edge fwd = {to, cap, cost};
+  Edge rev = {from, 0, -cost};
+  edges_.push_back(fwd);
+  next_.push_back(head_[from]);
+  head_[from] = edges_.size() - 1;
+  edges_.push_back(rev);
+  next_.push_back(head_[to]);
+  head_[to] = edges_.size() - 1;
+  return edges_.size() - 2;
+}
+
+void MinCostFlowSolver::SuccessiveShortestPaths() {
+  // all costs are nonnegative, so zero potentials are feasible
+  pot_.assign(head_.size(), 0);
+  while (ShortestPaths()) {
+    for (int n = 0; n != pot_.size(); ++n) {
+      if (dist_[n] < kInf) {
+        pot_[n] += dist_[n];
+      }
+    }
+
+    double flow = kInf;
+    for (int n = 1; n != 0; n = edges_[pred_[n] ^ 1].to) {
+      flow = std::min(flow, edges_[pred_[n]].cap);
+    }
+    for (int n = 1; n != 0; n = edges_[pred_[n] ^ 1].to) {
+      edges_[pred_[n]].cap -= flow;
+      edges_[pred_[n] ^ 1].cap += flow;
+    }
+  }
+}
+
+bool MinCostFlowSolver::ShortestPaths() {
+  typedef std::pair<double, int> Entry;
+  std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry> > queue;
+  dist_.assign(head_.size(), kInf);
+  pred_.assign(head_.size(), -1);
+  dist_[0] = 0;
+  queue.push(Entry(0, 0));
+  while (!queue.empty()) {
+    Entry top = queue.top();
+    queue.pop();
+    int n = top.second;
+    if (top.first > dist_[n]) {
+      continue;
+    }
+
+    for (int e = head_[n]; e != -1; e = next_[e]) {
+      const Edge& edge = edges_[e];
+      if (edge.cap <= eps()) {
+        continue;
+      }
+
+      // reduced costs are nonnegative up to round off
+      double reduced = std::max(0.0, edge.cost + pot_[n] - pot_[edge.to]);
+      double d = dist_[n] + reduced;
+      if (d < dist_[edge.to]) {
+        dist_[edge.to] = d;
+        pred_[edge.to] = e;
+        queue.push(Entry(d, edge.to));
+      }
+    }
+  }
+  return dist_[1] < kInf;
+}
+
+}  // namespace cyclus
@@ -0,0 +1,100 @@
+#ifndef CYCLUS_SRC_MIN_COST_FLOW_SOLVER_H_
+#define CYCLUS_SRC_MIN_COST_FLOW_SOLVER_H_
+
+#include <vector>
+
+#include "exchange_graph.h"
+#include "exchange_solver.h"
+
+namespace cyclus {
+
+/// @brief The MinCostFlowSolver provides an optimal solution to exchange
+/// graphs that can be expressed as a pure network flow problem, without
+/// building a linear program.
+///
+/// A graph is solved natively if none of its arcs are exclusive (or exclusive
+/// orders are not allowed), every node group has at most one capacity
+/// constraint, the unit capacities of all arcs within a group are identical
+/// and positive, and all preferences are positive. The graph is then
+/// translated into a flow network
+///
+///   source -> supply group -> request group -> sink
+///
+/// in which supply groups are bounded by their capacity, each arc by the
+/// quantities of its request and bid nodes and each request group by its
+/// demand. Each unit of flow on an arc costs 1 / preference, and each request
+/// group may additionally be fed directly by the source at the pseudo cost of
+/// unmet demand, exactly as the faux arcs of the ProgTranslator. The network is
+/// solved with the successive shortest path algorithm using Dijkstra's
+/// algorithm on reduced costs.
+///
+/// All other graphs (most notably those with exclusive arcs) are handed to the
+/// fallback solver, by default a ProgSolver using Cbc if Cyclus was compiled
+/// with COIN support and a GreedySolver otherwise.
+///
+/// @warning the MinCostFlowSolver is responsible for deleting its fallback
+/// solver!
+class MinCostFlowSolver : public ExchangeSolver {
+ public:
+  /// @param exclusive_orders a flag for enforcing integral, quantized orders
+  /// @param fallback the solver used for graphs that are not pure flow
+  /// problems, the default is used if NULL
+  /// @{
+  explicit MinCostFlowSolver(bool exclusive_orders = kDefaultExclusive);
+  MinCostFlowSolver(bool exclusive_orders, ExchangeSolver* fallback);
+  /// @}
+
+  virtual ~MinCostFlowSolver();
+
+  /// @return a new MinCostFlowSolver with a clone of the fallback solver, or
+  /// NULL if the fallback solver cannot be cloned
+  virtual ExchangeSolver* Clone() const;
+
+  /// @return whether the most recently solved graph was handed to the
+  /// fallback solver
+  inline bool used_fallback() const { return used_fallback_; }
+
+  /// @return true if the graph can be solved as a pure network flow problem
+  /// given this solver's exclusive orders setting
+  bool IsFlowProblem(const ExchangeGraph* g) const;
+
+ protected:
+  /// @brief solves the graph natively if possible, otherwise with the fallback
+  /// solver
+  virtual double SolveGraph();
+
+ private:
+  /// residual network edge, edges 2i and 2i + 1 are each other's reverse
+  struct Edge {
+    int to;
+    double cap;
+    double cost;
+  };
+
+  /// @brief adds an edge and its reverse to the network
+  /// @return the id of the forward edge
+  int AddEdge(int from, int to, double cap, double cost);
+
+  /// @brief pushes the cheapest possible flow from the source (node 0) to the
+  /// sink (node 1)
+  void SuccessiveShortestPaths();
+
+  /// @brief finds the shortest path tree from the source w.r.t. reduced costs
+  /// @return false if the sink is not reachable
+  bool ShortestPaths();
+
+  ExchangeSolver* fallback_;
+  bool used_fallback_;
+
+  // forward-star representation of the residual network
+  std::vector<int> head_;
+  std::vector<int> next_;
+  std::vector<Edge> edges_;
+  std::vector<double> pot_;
+  std::vector<double> dist_;
+  std::vector<int> pred_;
+};
+
+}  // namespace cyclus
+
+#endif  // CYCLUS_SRC_MIN_COST_FLOW_SOLVER_H_
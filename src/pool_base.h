@@ -0,0 +1,74 @@
+#ifndef CYCLUS_SRC_POOL_BASE_H_
+#define CYCLUS_SRC_POOL_BASE_H_
+
+#include <cstddef>
+#include <new>
+#include <boost/checked_delete.hpp>
+#include <boost/pool/pool_alloc.hpp>
+#include <boost/pool/singleton_pool.hpp>
+#include <boost/shared_ptr.hpp>
+
+namespace cyclus {
+
+/// PoolBase provides class-specific allocation for a (sub) class from a
+/// thread-safe slab pool rather than the general purpose heap. This is useful
+/// for small objects that are created and destroyed in very large numbers
+/// (e.g. materials and compositions created during resource exchange).
+///
+/// To use it, a class should inherit from PoolBase with itself as the
+/// template parameter and create its smart pointers with NewPooledPtr, which
+/// also allocates the shared pointer's control block from a pool:
+/// @code
+/// class Material : public Resource, public PoolBase<Material> {
+/// ...
+/// };
+///
+/// Material::Ptr m = NewPooledPtr(new Material(...));
+/// @endcode
+///
+/// Only objects with exactly the size of Derived are pooled - instances of
+/// further subclasses fall back to the global operator new/delete, so
+/// subclassing a pooled class remains safe.
+template <class Derived> class PoolBase {
+ public:
+  static void* operator new(std::size_t size) {
+    if (size != sizeof(Derived)) {
+      return ::operator new(size);
+    }
+    void* p = boost::singleton_pool<PoolTag, sizeof(Derived)>::malloc();
+    if (p == NULL) {
+      throw std::bad_alloc();
+    }
+    return p;
+  }
+
+  static void operator delete(void* p, std::size_t size) {
+    if (p == NULL) {
+      return;
+    } else if (size != sizeof(Derived)) {
+      ::operator delete(p);
+      return;
+    }
+    boost::singleton_pool<PoolTag, sizeof(Derived)>::free(p);
+  }
+
+ protected:
+  PoolBase() {}
+
+  ~PoolBase() {}
+
+ private:
+  /// tags the singleton pool used for Derived objects
+  struct PoolTag {};
+};
+
+/// Wraps a newly allocated object in a boost::shared_ptr whose reference
+/// count control block is allocated from a pool.
+template <class T> boost::shared_ptr<T> NewPooledPtr(T* p) {
+  return boost::shared_ptr<T>(p, boost::checked_deleter<T>(),
+                              boost::fast_pool_allocator<T>());
+}
+
+}  // namespace cyclus
+
+#endif  // CYCLUS_SRC_POOL_BASE_H_
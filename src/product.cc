@@ -14,11 +14,17 @@ int Product::next_qualid_ = 1;
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Product::Ptr Product::Create(Agent* creator, double quantity,
                              std::string quality, std::string package_name) {
+  // products may be created by agents running concurrently
+  int qualid = 0;
+#pragma omp critical(cyclus_product_qualids)
   if (qualids_.count(quality) == 0) {
-    qualids_[quality] = next_qualid_++;
+    qualid = next_qualid_++;
+    qualids_[quality] = qualid;
+  }
+  if (qualid > 0) {
     creator->context()
         ->NewDatum("Products")
-        ->AddVal("QualId", qualids_[quality])
+        ->AddVal("QualId", qualid)
         ->AddVal("Quality", quality)
         ->Record();
   }
@@ -37,6 +43,14 @@ Product::Ptr Product::CreateUntracked(double quantity, std::string quality) {
   return r;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+int Product::qual_id() const {
+  int qualid;
+#pragma omp critical(cyclus_product_qualids)
+  qualid = qualids_[quality_];
+  return qualid;
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 Resource::Ptr Product::Clone() const {
   Product* g = new Product(*this);
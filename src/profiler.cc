@@ -0,0 +1,140 @@
+#include "profiler.h"
+
+#include <iomanip>
+
+#include "agent.h"
+#include "context.h"
+#include "error.h"
+#include "platform.h"
+#if CYCLUS_IS_PARALLEL
+#include <omp.h>
+#endif  // CYCLUS_IS_PARALLEL
+
+namespace cyclus {
+
+bool Profiler::on_ = false;
+std::string Profiler::trace_file_ = "";
+
+Profiler::Profiler()
+    : enabled_(on_),
+      trace_path_(trace_file_),
+      epoch_(Clock::now()),
+      n_traced_(0) {}
+
+void Profiler::Add(const char* phase, int time, int agent,
+                   Clock::time_point start, Clock::time_point end) {
+  double dur = std::chrono::duration<double>(end - start).count();
+  int thread = 0;
+#if CYCLUS_IS_PARALLEL
+  thread = omp_get_thread_num();
+#endif  // CYCLUS_IS_PARALLEL
+
+#pragma omp critical(cyclus_profiler)
+  {
+    Stat& s = agent < 0 ? phases_[std::make_pair(time, std::string(phase))]
+                        : agents_[std::make_pair(agent, std::string(phase))];
+    s.calls++;
+    s.duration += dur;
+    if (!trace_path_.empty()) {
+      Event e = {phase, time, agent, thread,
+                 std::chrono::duration<double>(start - epoch_).count(), dur};
+      events_.push_back(e);
+    }
+  }
+}
+
+void Profiler::Flush(Context* ctx) {
+  std::map<std::pair<int, std::string>, Stat>::iterator it;
+  for (it = phases_.begin(); it != phases_.end(); ++it) {
+    ctx->NewDatum("Profile")
+        ->AddVal("AgentId", -1)
+        ->AddVal("Phase", it->first.second)
+        ->AddVal("Time", it->first.first)
+        ->AddVal("Calls", it->second.calls)
+        ->AddVal("Duration", it->second.duration)
+        ->Record();
+  }
+  phases_.clear();
+
+  if (!trace_path_.empty()) {
+    WriteTrace();
+  }
+  events_.clear();
+}
+
+void Profiler::Record(Context* ctx) {
+  Flush(ctx);
+  std::map<std::pair<int, std::string>, Stat>::iterator it;
+  for (it = agents_.begin(); it != agents_.end(); ++it) {
+    ctx->NewDatum("Profile")
+        ->AddVal("AgentId", it->first.first)
+        ->AddVal("Phase", it->first.second)
+        ->AddVal("Time", -1)
+        ->AddVal("Calls", it->second.calls)
+        ->AddVal("Duration", it->second.duration)
+        ->Record();
+  }
+  agents_.clear();
+
+  if (trace_.is_open()) {
+    trace_ << "\n], \"displayTimeUnit\": \"ms\"}\n";
+    trace_.close();
+  }
+  n_traced_ = 0;
+  epoch_ = Clock::now();
+}
+
+void Profiler::WriteTrace() {
+  if (!trace_.is_open()) {
+    trace_.open(trace_path_.c_str());
+    if (!trace_) {
+      throw IOError("could not open profile trace file " + trace_path_);
+    }
+    // complete ("X") events with timestamps in microseconds
+    trace_ << "{\"traceEvents\": [";
+    trace_ << std::fixed << std::setprecision(3);
+  }
+
+  for (size_t i = 0; i < events_.size(); ++i) {
+    const Event& e = events_[i];
+    trace_ << (n_traced_++ == 0 ? "\n" : ",\n")
+           << "{\"name\": \"" << e.phase << "\", "
+           << "\"cat\": \"" << (e.agent < 0 ? "phase" : "agent") << "\", "
+           << "\"ph\": \"X\", \"pid\": 0, \"tid\": " << e.thread << ", "
+           << "\"ts\": " << e.start * 1e6 << ", \"dur\": " << e.duration * 1e6
+           << ", \"args\": {\"time\": " << e.time;
+    if (e.agent >= 0) {
+      trace_ << ", \"agent\": " << e.agent;
+    }
+    trace_ << "}}";
+  }
+  trace_.flush();
+}
+
+ProfileScope::ProfileScope(Context* ctx, const char* phase, int agent)
+    : prof_(NULL), phase_(phase), time_(0), agent_(agent) {
+  if (ctx != NULL && ctx->profiler()->enabled()) {
+    prof_ = ctx->profiler();
+    time_ = ctx->time();
+    start_ = Profiler::Clock::now();
+  }
+}
+
+ProfileScope::ProfileScope(Agent* agent, const char* phase)
+    : prof_(NULL), phase_(phase), time_(0), agent_(-1) {
+  Context* ctx = agent == NULL ? NULL : agent->context();
+  if (ctx != NULL && ctx->profiler()->enabled()) {
+    prof_ = ctx->profiler();
+    time_ = ctx->time();
+    agent_ = agent->id();
+    start_ = Profiler::Clock::now();
+  }
+}
+
+ProfileScope::~ProfileScope() {
+  if (prof_ != NULL) {
+    prof_->Add(phase_, time_, agent_, start_, Profiler::Clock::now());
+  }
+}
+
+}  // namespace cyclus
@@ -0,0 +1,131 @@
+#ifndef CYCLUS_SRC_PROFILER_H_
+#define CYCLUS_SRC_PROFILER_H_
+
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace cyclus {
+
+class Agent;
+class Context;
+
+/// @brief The Profiler measures the wall time spent in each simulation phase
+/// (Build, Tick, ResourceExchange, Tock, Decision, Decom) per time step and
+/// in each agent callback (Tick, Tock, Decision, GetMatlRequests,
+/// GetMatlBids, GetMatlTrades, AcceptMatlTrades, ...) per agent.
+///
+/// The aggregates are recorded to the Profile table with the columns AgentId,
+/// Phase, Time, Calls and Duration (in seconds). Rows of whole phases have an
+/// AgentId of -1 and are recorded at the end of each time step (see Flush),
+/// rows of agents are totals over the simulation with a Time of -1 and are
+/// recorded at its end. If a trace file is set, every measured call is
+/// additionally written to it in the Chrome trace event format (see
+/// chrome://tracing or https://ui.perfetto.dev), also at the end of each
+/// time step, so that memory use does not grow with the simulation's length.
+/// Exchanges additionally record the ExchangeProfile table while the profiler
+/// is enabled (see ExchangeManager).
+///
+/// Profiling is disabled by default, in which case ProfileScope costs a
+/// single branch. Calls may be measured concurrently from several threads.
+class Profiler {
+ public:
+  typedef std::chrono::steady_clock Clock;
+
+  /// the settings of new profilers (e.g. from the command line)
+  /// @{
+  static bool& On() { return on_; }
+  static std::string& TraceFile() { return trace_file_; }
+  /// @}
+
+  Profiler();
+
+  inline bool enabled() const { return enabled_; }
+  inline void enabled(bool e) { enabled_ = e; }
+
+  inline const std::string& trace_file() const { return trace_path_; }
+  inline void trace_file(const std::string& path) { trace_path_ = path; }
+
+  /// @brief adds a measured call
+  /// @param phase the phase name, which must outlive the profiler
+  /// @param time the time step
+  /// @param agent the agent id, or -1 for a whole phase
+  void Add(const char* phase, int time, int agent, Clock::time_point start,
+           Clock::time_point end);
+
+  /// @brief records the Profile rows of whole phases, appends the calls
+  /// measured so far to the trace file if set and clears them
+  void Flush(Context* ctx);
+
+  /// @brief flushes, records the Profile rows of agents, completes the trace
+  /// file if set and clears all measurements
+  void Record(Context* ctx);
+
+ private:
+  struct Stat {
+    Stat() : calls(0), duration(0) {}
+    int calls;
+    double duration;
+  };
+
+  struct Event {
+    const char* phase;
+    int time;
+    int agent;
+    int thread;
+    double start;
+    double duration;
+  };
+
+  void WriteTrace();
+
+  bool enabled_;
+  std::string trace_path_;
+  Clock::time_point epoch_;
+  /// by (time, phase) for phases and by (agent, phase) for agents
+  std::map<std::pair<int, std::string>, Stat> phases_;
+  std::map<std::pair<int, std::string>, Stat> agents_;
+  std::vector<Event> events_;
+  /// the trace file while it is being written and the events written to it
+  std::ofstream trace_;
+  int n_traced_;
+
+  static bool on_;
+  static std::string trace_file_;
+};
+
+/// @brief ProfileScope measures its own lifetime as a call of the given
+/// phase in the current time step, if the context's profiler is enabled
+///
+/// @code
+/// {
+///   ProfileScope prof(ctx, "Tick", agent->id());
+///   agent->Tick();
+/// }
+/// @endcode
+class ProfileScope {
+ public:
+  /// @param ctx the simulation context, may be NULL
+  /// @param phase the phase name, which must be a string literal
+  /// @param agent the agent id, or -1 for a whole phase
+  ProfileScope(Context* ctx, const char* phase, int agent = -1);
+
+  /// measures a call of the given agent, which may be NULL
+  ProfileScope(Agent* agent, const char* phase);
+
+  ~ProfileScope();
+
+ private:
+  Profiler* prof_;
+  const char* phase_;
+  int time_;
+  int agent_;
+  Profiler::Clock::time_point start_;
+};
+
+}  // namespace cyclus
+
+#endif  // CYCLUS_SRC_PROFILER_H_
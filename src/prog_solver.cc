@@ -1,8 +1,13 @@
 #include "prog_solver.h"
 
+#include <algorithm>
 #include <sstream>
 
+#include "CoinWarmStart.hpp"
+
 #include "context.h"
+#include "cyc_limits.h"
+#include "logger.h"
 #include "prog_translator.h"
 #include "greedy_solver.h"
 #include "solver_factory.h"
@@ -15,11 +20,32 @@ void Report(OsiSolverInterface* iface) {
   std::cout << iface->getNumRows() << " constraints\n";
 }
 
+/// warm start state of one exchange (component)
+struct ProgSolver::WarmStart {
+  WarmStart() : time(0) {}
+
+  /// the time step in which the state was last used
+  int time;
+  /// the arcs of the previous solve
+  std::vector<ArcKey> keys;
+  /// the flow of each arc in the previous solve
+  std::vector<double> solution;
+  /// the basis of the previous (linear) program
+  boost::shared_ptr<CoinWarmStart> basis;
+};
+
 ProgSolver::ProgSolver(std::string solver_t)
     : solver_t_(solver_t),
       tmax_(ProgSolver::kDefaultTimeout),
       verbose_(false),
       mps_(false),
+      warm_start_(false),
+      greedy_start_(true),
+      relax_and_round_(false),
+      relaxed_(false),
+      warm_started_(false),
+      warm_cache_(new WarmStartCache()),
+      iface_(NULL),
       ExchangeSolver(false) {}
 
 ProgSolver::ProgSolver(std::string solver_t, bool exclusive_orders)
@@ -27,6 +53,13 @@ ProgSolver::ProgSolver(std::string solver_t, bool exclusive_orders)
       tmax_(ProgSolver::kDefaultTimeout),
       verbose_(false),
       mps_(false),
+      warm_start_(false),
+      greedy_start_(true),
+      relax_and_round_(false),
+      relaxed_(false),
+      warm_started_(false),
+      warm_cache_(new WarmStartCache()),
+      iface_(NULL),
       ExchangeSolver(exclusive_orders) {}
 
 ProgSolver::ProgSolver(std::string solver_t, double tmax)
@@ -34,6 +67,13 @@ ProgSolver::ProgSolver(std::string solver_t, double tmax)
       tmax_(tmax),
       verbose_(false),
       mps_(false),
+      warm_start_(false),
+      greedy_start_(true),
+      relax_and_round_(false),
+      relaxed_(false),
+      warm_started_(false),
+      warm_cache_(new WarmStartCache()),
+      iface_(NULL),
       ExchangeSolver(false) {}
 
 ProgSolver::ProgSolver(std::string solver_t, double tmax, bool exclusive_orders,
@@ -42,55 +82,322 @@ ProgSolver::ProgSolver(std::string solver_t, double tmax, bool exclusive_orders,
       tmax_(tmax),
       verbose_(verbose),
       mps_(mps),
+      warm_start_(false),
+      greedy_start_(true),
+      relax_and_round_(false),
+      relaxed_(false),
+      warm_started_(false),
+      warm_cache_(new WarmStartCache()),
+      iface_(NULL),
       ExchangeSolver(exclusive_orders) {}
 
-ProgSolver::~ProgSolver() {}
+ProgSolver::~ProgSolver() {
+  if (iface_ != NULL) delete iface_;
+}
+
+ExchangeSolver* ProgSolver::Clone() const {
+  ProgSolver* s =
+      new ProgSolver(solver_t_, tmax_, exclusive_orders_, verbose_, mps_);
+  s->warm_start_ = warm_start_;
+  s->greedy_start_ = greedy_start_;
+  s->relax_and_round_ = relax_and_round_;
+  s->warm_cache_ = warm_cache_;
+  return s;
+}
+
+boost::shared_ptr<ProgSolver::WarmStart> ProgSolver::GetWarmStart(
+    const std::vector<ArcKey>& keys) {
+  int time = sim_ctx_ != NULL ? sim_ctx_->time() : 0;
+  boost::shared_ptr<WarmStart> ws;
+  // clones solving components concurrently share the cache
+#pragma omp critical(cyclus_prog_solver_warm_cache)
+  {
+    WarmStartCache::iterator it = warm_cache_->begin();
+    while (it != warm_cache_->end()) {
+      if (it->second->time < time - 1) {
+        warm_cache_->erase(it++);
+      } else {
+        ++it;
+      }
+    }
+
+    boost::shared_ptr<WarmStart>& entry = (*warm_cache_)[keys[0]];
+    if (!entry) {
+      entry.reset(new WarmStart());
+    }
+    entry->time = time;
+    ws = entry;
+  }
+  return ws;
+}
+
+namespace {
+
+/// orders columns by descending value in a solution
+struct ValueComp {
+  explicit ValueComp(const double* sol) : sol(sol) {}
+  bool operator()(int l, int r) const { return sol[l] > sol[r]; }
+  const double* sol;
+};
+
+}  // namespace
+
+std::vector<double> CompleteStart(const ProgTranslatorContext& ctx,
+                                  const std::vector<double>& flows) {
+  int n_arcs = flows.size();
+  std::vector<double> start(ctx.m.getNumCols(), 0);
+  for (int c = 0; c != n_arcs; c++) {
+    start[c] = std::max(ctx.col_lbs[c], std::min(flows[c], ctx.col_ubs[c]));
+  }
+
+  std::vector<double> activity(ctx.row_lbs.size(), 0);
+  const CoinBigIndex* starts = ctx.m.getVectorStarts();
+  const int* lens = ctx.m.getVectorLengths();
+  const int* idx = ctx.m.getIndices();
+  const double* vals = ctx.m.getElements();
+  for (int c = 0; c != n_arcs; c++) {
+    for (CoinBigIndex k = starts[c]; k != starts[c] + lens[c]; k++) {
+      activity[idx[k]] += vals[k] * start[c];
+    }
+  }
+  for (int c = n_arcs; c != ctx.m.getMajorDim(); c++) {
+    for (CoinBigIndex k = starts[c]; k != starts[c] + lens[c]; k++) {
+      int r = idx[k];
+      start[c] = std::max(start[c], ctx.row_lbs[r] - activity[r]);
+    }
+  }
+  return start;
+}
+
+std::vector<double> RoundedFlows(const ProgTranslatorContext& ctx,
+                                 int n_arcs, const double* sol,
+                                 std::vector<int> frac) {
+  std::vector<double> flows(sol, sol + n_arcs);
+  for (int i = 0; i != frac.size(); i++) {
+    flows[frac[i]] = 0;
+  }
+
+  std::vector<double> activity(ctx.row_lbs.size(), 0);
+  const CoinBigIndex* starts = ctx.m.getVectorStarts();
+  const int* lens = ctx.m.getVectorLengths();
+  const int* idx = ctx.m.getIndices();
+  const double* vals = ctx.m.getElements();
+  for (int c = 0; c != n_arcs; c++) {
+    for (CoinBigIndex k = starts[c]; k != starts[c] + lens[c]; k++) {
+      activity[idx[k]] += vals[k] * flows[c];
+    }
+  }
+
+  std::stable_sort(frac.begin(), frac.end(), ValueComp(sol));
+  for (int i = 0; i != frac.size(); i++) {
+    int c = frac[i];
+    bool fits = true;
+    for (CoinBigIndex k = starts[c]; fits && k != starts[c] + lens[c]; k++) {
+      int r = idx[k];
+      fits = !IsNegative(ctx.row_ubs[r] - activity[r] - vals[k]);
+    }
+    if (fits) {
+      flows[c] = 1;
+      for (CoinBigIndex k = starts[c]; k != starts[c] + lens[c]; k++) {
+        activity[idx[k]] += vals[k];
+      }
+    }
+  }
+  return flows;
+}
+
+std::vector<double> ProgSolver::StartSolution(
+    const WarmStart& ws, const std::vector<ArcKey>& keys,
+    const ProgTranslatorContext& ctx) {
+  std::map<ArcKey, double> prev;
+  for (int i = 0; i != ws.keys.size(); i++) {
+    prev[ws.keys[i]] = ws.solution[i];
+  }
+
+  // arcs keep their previous flow
+  std::vector<double> flows(keys.size(), 0);
+  for (int i = 0; i != keys.size(); i++) {
+    std::map<ArcKey, double>::iterator it = prev.find(keys[i]);
+    if (it != prev.end()) {
+      flows[i] = it->second;
+    }
+  }
+  return CompleteStart(ctx, flows);
+}
+
+std::vector<double> ProgSolver::GreedyFlows(double* obj) {
+  // the graph has already been conditioned
+  GreedySolver greedy(exclusive_orders_, NULL);
+  *obj = greedy.Solve(graph_);
+
+  // exclusive arcs are binary columns in the program
+  const CompactGraph& cg = graph_->compact();
+  std::vector<double> flows(cg.n_arcs(), 0);
+  const std::vector<Match>& matches = graph_->matches();
+  for (int i = 0; i != matches.size(); i++) {
+    const Arc& a = matches[i].first;
+    int u = cg.node_id(a.unode().get());
+    int v = cg.node_id(a.vnode().get());
+    for (int k = cg.adj_start[u]; k != cg.adj_start[u + 1]; k++) {
+      int arc = cg.adj_arcs[k];
+      if (cg.arc_unode[arc] == u && cg.arc_vnode[arc] == v) {
+        flows[arc] = matches[i].second;
+        if (exclusive_orders_ && cg.arc_exclusive[arc]) {
+          flows[arc] /= cg.arc_excl_val[arc];
+        }
+        break;
+      }
+    }
+  }
+  graph_->ClearMatches();
+  return flows;
+}
+
+bool ProgSolver::RelaxAndRound(const ProgTranslatorContext& ctx,
+                               std::vector<double>* start) {
+  int n_arcs = graph_->arcs().size();
+  std::vector<int> ints;
+  for (int i = 0; i != n_arcs; i++) {
+    if (iface_->isInteger(i)) {
+      ints.push_back(i);
+      iface_->setContinuous(i);
+    }
+  }
+  iface_->initialSolve();
+  for (int i = 0; i != ints.size(); i++) {
+    iface_->setInteger(ints[i]);
+  }
+  if (!iface_->isProvenOptimal()) {
+    return false;  // leave the program to Cbc as is
+  }
+
+  // exclusive columns are binary, fix those that are integral
+  const double* sol = iface_->getColSolution();
+  std::vector<int> frac;
+  for (int i = 0; i != ints.size(); i++) {
+    int c = ints[i];
+    if (sol[c] <= eps()) {
+      iface_->setColUpper(c, 0);
+    } else if (sol[c] >= 1 - eps()) {
+      iface_->setColLower(c, 1);
+    } else {
+      frac.push_back(c);
+    }
+  }
+  CLOG(LEV_DEBUG1) << frac.size() << " of " << ints.size()
+                   << " exclusive arcs are fractional in the relaxation.";
+  if (frac.empty()) {
+    return true;
+  }
+
+  *start = CompleteStart(ctx, RoundedFlows(ctx, n_arcs, sol, frac));
+  return false;
+}
+
+OsiSolverInterface* ProgSolver::Interface() {
+  if (iface_ == NULL) {
+    SolverFactory sf(solver_t_, tmax_);
+    iface_ = sf.get();
+    iface_->passInMessageHandler(&handler_);
+  }
+  return iface_;
+}
 
 void ProgSolver::WriteMPS() {
   std::stringstream ss;
   ss << "exchng_" << sim_ctx_->time();
+  if (component_ >= 0) ss << "_" << component_;
   iface_->writeMps(ss.str().c_str());
 }
 
 double ProgSolver::SolveGraph() {
-  SolverFactory sf(solver_t_, tmax_);
-  iface_ = sf.get();
-  try {
-    // get greedy solution
-    GreedySolver greedy(exclusive_orders_);
-    double greedy_obj = greedy.Solve(graph_);
-    graph_->ClearMatches();
-
-    // translate graph to iface_ instance
-    double pseudo_cost = PseudoCost();  // from ExchangeSolver API
-    ProgTranslator xlator(graph_, iface_, exclusive_orders_, pseudo_cost);
-    xlator.ToProg();
-    if (mps_) WriteMPS();
-
-    // set noise level
-    CoinMessageHandler h;
-    h.setLogLevel(0);
-    if (verbose_) {
-      Report(iface_);
-      h.setLogLevel(4);
+  std::vector<ArcKey> keys;
+  boost::shared_ptr<WarmStart> ws;
+  if (warm_start_ && !graph_->arcs().empty()) {
+    keys = ArcKeys(*graph_);
+    ws = GetWarmStart(keys);
+  }
+  bool has_prev = ws && !ws->solution.empty();
+
+  // groups are conditioned as for the greedy solver before translation for
+  // both linear and mixed integer programs, since their order breaks ties
+  // between equally preferred solutions
+  GreedyPreconditioner conditioner;
+  conditioner.Condition(graph_);
+
+  // only mixed integer programs are started from the greedy solution
+  const CompactGraph& cg = graph_->compact();
+  bool mip = false;
+  for (int i = 0; exclusive_orders_ && !mip && i != cg.n_arcs(); i++) {
+    mip = cg.arc_exclusive[i];
+  }
+  Interface();
+  double greedy_obj = iface_->getInfinity();
+  std::vector<double> greedy_flows;
+  if (mip && greedy_start_ && !has_prev && !relax_and_round_) {
+    greedy_flows = GreedyFlows(&greedy_obj);
+  }
+
+  // translate graph to the (reused) iface_ instance
+  double pseudo_cost = PseudoCost();  // from ExchangeSolver API
+  ProgTranslator xlator(graph_, iface_, exclusive_orders_, pseudo_cost);
+  xlator.ToProg();
+  if (mps_) WriteMPS();
+
+  // start from the previous basis if the program has the same arcs (SolveProg
+  // checks its shape), and from the previous (or greedy) solution in any case
+  std::vector<double> start;
+  const CoinWarmStart* basis = NULL;
+  if (has_prev) {
+    if (ws->keys == keys) {
+      basis = ws->basis.get();
     }
-    iface_->passInMessageHandler(&h);
-    if (verbose_) {
-      std::cout << "Solving problem, message handler has log level of "
-                << iface_->messageHandler()->logLevel() << "\n";
+    start = StartSolution(*ws, keys, xlator.ctx());
+  } else if (!greedy_flows.empty()) {
+    start = CompleteStart(xlator.ctx(), greedy_flows);
+  }
+
+  // an integral relaxation needs no branch and bound
+  bool relaxed = false;
+  if (mip && relax_and_round_) {
+    std::vector<double> rounded;
+    relaxed = RelaxAndRound(xlator.ctx(), &rounded);
+    if (!rounded.empty()) {
+      start = rounded;
     }
+  }
 
-    // solve and back translate
-    SolveProg(iface_, greedy_obj, verbose_);
+  // set noise level
+  handler_.setLogLevel(0);
+  if (verbose_) {
+    Report(iface_);
+    handler_.setLogLevel(4);
+  }
+  if (verbose_) {
+    std::cout << "Solving problem, message handler has log level of "
+              << iface_->messageHandler()->logLevel() << "\n";
+  }
 
-    xlator.FromProg();
-  } catch (...) {
-    delete iface_;
-    throw;
+  // solve and back translate
+  relaxed_ = relaxed;
+  warm_started_ = false;
+  if (!relaxed) {
+    warm_started_ = SolveProg(iface_, greedy_obj, verbose_,
+                              start.empty() ? NULL : &start[0], basis);
+  }
+
+  xlator.FromProg();
+
+  if (ws) {
+    const double* sol = iface_->getColSolution();
+    ws->keys = keys;
+    ws->solution.assign(sol, sol + keys.size());
+    ws->basis.reset();
+    if (!HasInt(iface_)) {
+      ws->basis.reset(iface_->getWarmStart());
+    }
   }
-  double ret = iface_->getObjValue();
-  delete iface_;
-  return ret;
+  return iface_->getObjValue();
 }
 
 }  // namespace cyclus
@@ -3,7 +3,10 @@
 #include "platform.h"
 #if CYCLUS_HAS_COIN
 
+#include <map>
 #include <string>
+#include <vector>
+#include <boost/shared_ptr.hpp>
 
 #include "OsiSolverInterface.hpp"
 
@@ -13,6 +16,7 @@
 namespace cyclus {
 
 class ExchangeGraph;
+struct ProgTranslatorContext;
 
 /// @brief The ProgSolver provides the implementation for a mathematical
 /// programming solution to a resource exchange graph.
@@ -25,7 +29,9 @@ class ProgSolver : public ExchangeSolver {
   /// @param exclusive_orders whether all orders must be exclusive or not,
   /// default false
   /// @param verbose print out a lot to stdout, default false
-  /// @param mps dump mps files for every solve, default false
+  /// @param mps dump mps files for every solve, default false. Files are
+  /// named exchng_<time>, or exchng_<time>_<component> for the components
+  /// solved by SolveComponents.
   /// @{
   ProgSolver(std::string solver_t);
   ProgSolver(std::string solver_t, double tmax);
@@ -35,19 +41,125 @@ class ProgSolver : public ExchangeSolver {
   /// @}
   virtual ~ProgSolver();
 
+  /// @return a new ProgSolver with the same settings, sharing this solver's
+  /// warm start state
+  virtual ExchangeSolver* Clone() const;
+
+  /// @brief whether to warm start each solve from the previous one
+  ///
+  /// In warm start (incremental) mode the solver keeps the basis and
+  /// solution of the previous solve of each exchange (or component
+  /// thereof, identified by its first arc's ArcKey). If the next instance has
+  /// the same arcs and its program as many columns and rows, that program is
+  /// solved starting from the previous basis. In all cases the previous solution, mapped onto the new
+  /// arcs by ArcKey, is offered to Cbc as a starting solution. State that has
+  /// not been used in the previous time step is discarded.
+  /// @{
+  inline void warm_start(bool w) { warm_start_ = w; }
+  inline bool warm_start() const { return warm_start_; }
+  /// @}
+
+  /// @brief whether to solve mixed integer programs greedily first
+  ///
+  /// If enabled (the default), the GreedySolver's solution of a graph with
+  /// exclusive arcs is offered to Cbc as its initial incumbent, unless a warm
+  /// start solution is available. Linear programs are never solved greedily,
+  /// but the groups of every graph are ordered by the GreedyPreconditioner
+  /// before translation, as for the GreedySolver.
+  /// @{
+  inline void greedy_start(bool g) { greedy_start_ = g; }
+  inline bool greedy_start() const { return greedy_start_; }
+  /// @}
+
+  /// @brief whether to solve mixed integer programs by relaxation and
+  /// rounding
+  ///
+  /// In this mode the linear relaxation of a graph with exclusive arcs is
+  /// solved first. Exclusive arcs with integral relaxed values are fixed at
+  /// those values and the remaining ones are rounded down and then greedily
+  /// back up, in order of descending relaxed value, as long as all
+  /// constraints hold. If any arc was fractional, Cbc solves the residual
+  /// program starting from the rounded solution; otherwise the relaxed
+  /// solution is optimal and Cbc is not invoked.
+  /// @{
+  inline void relax_and_round(bool r) { relax_and_round_ = r; }
+  inline bool relax_and_round() const { return relax_and_round_; }
+  /// @}
+
+  /// @return true if the last solve was settled by the linear relaxation
+  /// alone, without invoking Cbc (see relax_and_round)
+  inline bool relaxed() const { return relaxed_; }
+
+  /// @return true if the last solve started from the previous solve's basis
+  /// (see warm_start)
+  inline bool warm_started() const { return warm_started_; }
+
  protected:
   /// @brief the ProgSolver solves an ExchangeGraph...
   virtual double SolveGraph();
 
  private:
+  struct WarmStart;
+  typedef std::map<ArcKey, boost::shared_ptr<WarmStart>> WarmStartCache;
+
   void WriteMPS();
 
+  /// @brief returns the warm start state for a graph with the given arcs,
+  /// discarding stale state
+  boost::shared_ptr<WarmStart> GetWarmStart(const std::vector<ArcKey>& keys);
+
+  /// @brief the previous solution mapped onto the current program's columns
+  std::vector<double> StartSolution(const WarmStart& ws,
+                                    const std::vector<ArcKey>& keys,
+                                    const ProgTranslatorContext& ctx);
+
+  /// @brief solves the graph greedily, leaving it without matches
+  /// @param obj set to the greedy solution's objective value
+  /// @return the value of each arc's column in the greedy solution
+  std::vector<double> GreedyFlows(double* obj);
+
+  /// @brief solves the linear relaxation of the program in the interface and
+  /// fixes its integral exclusive arcs
+  /// @param start set to the rounded solution if arcs remain fractional
+  /// @return true if the relaxed solution is integral
+  bool RelaxAndRound(const ProgTranslatorContext& ctx,
+                     std::vector<double>* start);
+
+  /// @brief the solver interface, created on first use and reused by every
+  /// subsequent solve
+  OsiSolverInterface* Interface();
+
   std::string solver_t_;
   double tmax_;
   bool verbose_, mps_;
+  bool warm_start_;
+  bool greedy_start_;
+  bool relax_and_round_;
+  bool relaxed_;
+  bool warm_started_;
+  boost::shared_ptr<WarmStartCache> warm_cache_;
   OsiSolverInterface* iface_;
+  CoinMessageHandler handler_;
 };
 
+/// @brief maps the flows of all arcs onto the program's columns, within their
+/// bounds, and lets faux arcs make up for any unmet demand of their request
+/// group
+/// @return a full column solution
+std::vector<double> CompleteStart(const ProgTranslatorContext& ctx,
+                                  const std::vector<double>& flows);
+
+/// @brief rounds the fractional (binary) columns of a relaxed solution down
+/// and then, in order of descending relaxed value, back up to 1 as long as no
+/// row upper bound is violated
+/// @param n_arcs the number of (non-faux) arc columns
+/// @param sol the relaxed solution
+/// @param frac the fractional columns
+/// @return the resulting value of each arc's column
+std::vector<double> RoundedFlows(const ProgTranslatorContext& ctx,
+                                 int n_arcs, const double* sol,
+                                 std::vector<int> frac);
+
 }  // namespace cyclus
 #endif  // CYCLUS_HAS_COIN
 #endif  // CYCLUS_SRC_PROG_SOLVER_H_
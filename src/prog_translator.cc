@@ -13,6 +13,27 @@
 
 namespace cyclus {
 
+namespace {
+
+/// whether any of the nodes is the request node of an arc
+bool HasArcs(const CompactGraph& cg,
+             const std::vector<ExchangeNode::Ptr>& nodes) {
+  for (int i = 0; i != nodes.size(); i++) {
+    int n = cg.node_id(nodes[i].get());
+    if (n < 0) {
+      continue;
+    }
+    for (int k = cg.adj_start[n]; k != cg.adj_start[n + 1]; k++) {
+      if (cg.arc_unode[cg.adj_arcs[k]] == n) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+}  // namespace
+
 ProgTranslator::ProgTranslator(ExchangeGraph* g, OsiSolverInterface* iface)
     : g_(g),
       iface_(iface),
@@ -48,7 +69,7 @@ void ProgTranslator::Init() {
   ctx_.obj_coeffs.resize(n_cols);
   ctx_.col_ubs.resize(n_cols);
   ctx_.col_lbs.resize(n_cols);
-  ctx_.m = CoinPackedMatrix(false, 0, 0);
+  ctx_.m = CoinPackedMatrix(true, 0, 0);
 }
 
 void ProgTranslator::CheckPref(double pref) {
@@ -65,14 +86,11 @@ void ProgTranslator::CheckPref(double pref) {
 }
 
 void ProgTranslator::Translate() {
-  // number of variables = number of arcs + 1 faux arc per request group with
-  // arcs
-  int nfalse = 0;
-  std::vector<RequestGroup::Ptr>& rgs = g_->request_groups();
-  for (int i = 0; i != g_->request_groups().size(); ++i)
-    nfalse += rgs[i].get()->HasArcs() ? 1 : 0;
-  int n_cols = g_->arcs().size() + nfalse;
-  ctx_.m.setDimensions(0, n_cols);
+  rows_.clear();
+  cols_.clear();
+  vals_.clear();
+  ctx_.row_lbs.clear();
+  ctx_.row_ubs.clear();
 
   bool request;
   std::vector<ExchangeNodeGroup::Ptr>& sgs = g_->supply_groups();
@@ -81,6 +99,7 @@ void ProgTranslator::Translate() {
     XlateGrp_(sgs[i].get(), request);
   }
 
+  std::vector<RequestGroup::Ptr>& rgs = g_->request_groups();
   for (int i = 0; i != rgs.size(); i++) {
     request = true;
     XlateGrp_(rgs[i].get(), request);
@@ -95,6 +114,35 @@ void ProgTranslator::Translate() {
     ctx_.col_lbs[i] = 0;
     ctx_.col_ubs[i] = inf;
   }
+
+  // number of variables = number of arcs + 1 faux arc per request group with
+  // arcs; the coefficients were collected in row order and are laid out
+  // column by column, which keeps the rows of each column sorted
+  int n_cols = arc_offset_;
+  int n_rows = ctx_.row_lbs.size();
+  int nnz = vals_.size();
+  std::vector<CoinBigIndex> starts(n_cols + 1, 0);
+  for (int k = 0; k != nnz; k++) {
+    starts[cols_[k] + 1]++;
+  }
+  std::vector<int> lens(n_cols);
+  for (int c = 0; c != n_cols; c++) {
+    lens[c] = starts[c + 1];
+    starts[c + 1] += starts[c];
+  }
+
+  std::vector<int> inds(nnz);
+  std::vector<double> elems(nnz);
+  std::vector<CoinBigIndex> fill(starts.begin(), starts.end() - 1);
+  for (int k = 0; k != nnz; k++) {
+    CoinBigIndex pos = fill[cols_[k]]++;
+    inds[pos] = rows_[k];
+    elems[pos] = vals_[k];
+  }
+  ctx_.m = CoinPackedMatrix(true, n_rows, n_cols, nnz,
+                            nnz > 0 ? &elems[0] : NULL,
+                            nnz > 0 ? &inds[0] : NULL, &starts[0],
+                            n_cols > 0 ? &lens[0] : NULL);
 }
 
 void ProgTranslator::Populate() {
@@ -104,17 +152,23 @@ void ProgTranslator::Populate() {
   iface_->loadProblem(ctx_.m, &ctx_.col_lbs[0], &ctx_.col_ubs[0],
                       &ctx_.obj_coeffs[0], &ctx_.row_lbs[0], &ctx_.row_ubs[0]);
 
-  if (excl_) {
-    std::vector<Arc>& arcs = g_->arcs();
-    for (int i = 0; i != arcs.size(); i++) {
-      Arc& a = arcs[i];
-      if (a.exclusive()) {
-        iface_->setInteger(g_->arc_ids()[a]);
-      }
+  // set every arc's type, the interface may hold a previous program
+  const CompactGraph& cg = g_->compact();
+  for (int i = 0; i != cg.n_arcs(); i++) {
+    if (excl_ && cg.arc_exclusive[i]) {
+      iface_->setInteger(i);
+    } else {
+      iface_->setContinuous(i);
     }
   }
 }
 
+void ProgTranslator::AddCoeff(int row, int col, double val) {
+  rows_.push_back(row);
+  cols_.push_back(col);
+  vals_.push_back(val);
+}
+
 void ProgTranslator::ToProg() {
   Translate();
   Populate();
@@ -124,42 +178,43 @@ void ProgTranslator::XlateGrp_(ExchangeNodeGroup* grp, bool request) {
   double inf = iface_->getInfinity();
   std::vector<double>& caps = grp->capacities();
 
-  if (request && !grp->HasArcs())
+  const CompactGraph& cg = g_->compact();
+  const std::vector<Arc>& arcs = g_->arcs();
+  std::vector<ExchangeNode::Ptr>& nodes = grp->nodes();
+  if (request && !HasArcs(cg, nodes))
     return;  // no arcs, no reason to add variables/constraints
 
-  std::vector<CoinPackedVector> cap_rows;
-  std::vector<CoinPackedVector> excl_rows;
-  for (int i = 0; i != caps.size(); i++) {
-    cap_rows.push_back(CoinPackedVector());
-  }
-
-  std::vector<ExchangeNode::Ptr>& nodes = grp->nodes();
+  // capacity j of the group is row row0 + j
+  int row0 = ctx_.row_lbs.size();
   for (int i = 0; i != nodes.size(); i++) {
-    std::map<Arc, std::vector<double>>& ucap_map = nodes[i]->unit_capacities;
-    std::map<Arc, std::vector<double>>::iterator cap_it;
+    int n = cg.node_id(nodes[i].get());
+    if (n < 0) {
+      continue;
+    }
 
     // add each arc
-    for (cap_it = ucap_map.begin(); cap_it != ucap_map.end(); ++cap_it) {
-      const Arc& a = cap_it->first;
-      std::vector<double>& ucaps = cap_it->second;
-      int arc_id = g_->arc_ids()[a];
+    for (int k = cg.adj_start[n]; k != cg.adj_start[n + 1]; k++) {
+      int arc_id = cg.adj_arcs[k];
+      bool is_unode = cg.arc_unode[arc_id] == n;
+      const std::vector<int>& start = is_unode ? cg.ucap_start : cg.vcap_start;
+      const std::vector<double>& ucaps = is_unode ? cg.ucaps : cg.vcaps;
+      bool excl_arc = excl_ && cg.arc_exclusive[arc_id];
 
       // add each unit capacity coefficient
-      for (int j = 0; j != ucaps.size(); j++) {
+      for (int j = start[arc_id]; j != start[arc_id + 1]; j++) {
         double coeff = ucaps[j];
-        if (excl_ && a.exclusive()) {
-          coeff *= a.excl_val();
+        if (excl_arc) {
+          coeff *= cg.arc_excl_val[arc_id];
         }
-
-        cap_rows[j].insert(arc_id, coeff);
+        AddCoeff(row0 + j - start[arc_id], arc_id, coeff);
       }
 
-      if (request) {
+      if (request && is_unode) {
+        const Arc& a = arcs[arc_id];
         CheckPref(a.pref());
         ctx_.obj_coeffs[arc_id] = ExchangeSolver::Cost(a, excl_);
         ctx_.col_lbs[arc_id] = 0;
-        ctx_.col_ubs[arc_id] =
-            (excl_ && a.exclusive()) ? 1 : std::min(nodes[i]->qty, inf);
+        ctx_.col_ubs[arc_id] = excl_arc ? 1 : std::min(nodes[i]->qty, inf);
       }
     }
   }
@@ -170,9 +225,9 @@ void ProgTranslator::XlateGrp_(ExchangeNodeGroup* grp, bool request) {
   }
 
   // add all capacity rows
-  for (int i = 0; i != cap_rows.size(); i++) {
+  for (int i = 0; i != caps.size(); i++) {
     if (request) {
-      cap_rows[i].insert(faux_id, 1.0);  // faux arc
+      AddCoeff(row0 + i, faux_id, 1.0);  // faux arc
     }
 
     // 1e15 is the largest value that doesn't make the solver fall over
@@ -180,46 +235,43 @@ void ProgTranslator::XlateGrp_(ExchangeNodeGroup* grp, bool request) {
     double rlb = std::min(caps[i], 1e15);
     ctx_.row_lbs.push_back(request ? rlb : 0);
     ctx_.row_ubs.push_back(request ? inf : caps[i]);
-    ctx_.m.appendRow(cap_rows[i]);
   }
 
   if (excl_) {
-    // add exclusive arcs
+    // add exclusive arcs, one row per node group with arcs
     std::vector<std::vector<ExchangeNode::Ptr>>& exngs =
         grp->excl_node_groups();
     for (int i = 0; i != exngs.size(); i++) {
-      CoinPackedVector excl_row;
+      int row = ctx_.row_lbs.size();
+      int prev = vals_.size();
       std::vector<ExchangeNode::Ptr>& nodes = exngs[i];
       for (int j = 0; j != nodes.size(); j++) {
-        std::vector<Arc>& arcs = g_->node_arc_map()[nodes[j]];
-        for (int k = 0; k != arcs.size(); k++) {
-          excl_row.insert(g_->arc_ids()[arcs[k]], 1.0);
+        int n = cg.node_id(nodes[j].get());
+        if (n < 0) {
+          continue;
+        }
+        for (int k = cg.adj_start[n]; k != cg.adj_start[n + 1]; k++) {
+          AddCoeff(row, cg.adj_arcs[k], 1.0);
         }
       }
-      if (excl_row.getNumElements() > 0) {
-        excl_rows.push_back(excl_row);
+      if (vals_.size() != prev) {
+        ctx_.row_lbs.push_back(0.0);
+        ctx_.row_ubs.push_back(1.0);
       }
     }
-
-    // add all exclusive rows
-    for (int i = 0; i != excl_rows.size(); i++) {
-      ctx_.row_lbs.push_back(0.0);
-      ctx_.row_ubs.push_back(1.0);
-      ctx_.m.appendRow(excl_rows[i]);
-    }
   }
 }
 
 void ProgTranslator::FromProg() {
   const double* sol = iface_->getColSolution();
+  const CompactGraph& cg = g_->compact();
   std::vector<Arc>& arcs = g_->arcs();
   double flow;
   for (int i = 0; i < arcs.size(); i++) {
-    Arc& a = g_->arc_by_id().at(i);
     flow = sol[i];
-    flow = (excl_ && a.exclusive()) ? flow * a.excl_val() : flow;
+    flow = (excl_ && cg.arc_exclusive[i]) ? flow * cg.arc_excl_val[i] : flow;
     if (flow > cyclus::eps()) {
-      g_->AddMatch(a, flow);
+      g_->AddMatch(arcs[i], flow);
     }
   }
 }
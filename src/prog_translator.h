@@ -14,7 +14,8 @@ namespace cyclus {
 class ExchangeGraph;
 class ExchangeNodeGroup;
 
-/// @brief struct to hold all problem instance state
+/// @brief struct to hold all problem instance state, the constraint matrix is
+/// column ordered
 struct ProgTranslatorContext {
   std::vector<double> obj_coeffs;
   std::vector<double> row_ubs;
@@ -78,17 +79,24 @@ class ProgTranslator {
   /// @throws if preference is unsatisfactory (i.e., not greater than 0)
   void CheckPref(double pref);
 
-  /// perform all translation for a node group
+  /// perform all translation for a node group, appending its rows
   /// @param grp a pointer to the node group
   /// @param req a boolean flag, true if grp is a request group
   void XlateGrp_(ExchangeNodeGroup* grp, bool req);
 
+  /// @brief adds a constraint matrix coefficient
+  void AddCoeff(int row, int col, double val);
+
   ExchangeGraph* g_;
   OsiSolverInterface* iface_;
   bool excl_;
   int arc_offset_;
   ProgTranslatorContext ctx_;
   double pseudo_cost_;
+  /// the matrix coefficients in row order, as (row, column, value) triplets
+  std::vector<int> rows_;
+  std::vector<int> cols_;
+  std::vector<double> vals_;
 };
 
 }  // namespace cyclus
@@ -11,6 +11,9 @@
 namespace cyclus {
 int PY_INTERP_COUNT = 0;
 bool PY_INTERP_INIT = false;
+int PY_EVENT_LOOP_INTERVAL = 1;
+bool PY_EVENT_LOOP_ATTACHED = false;
+bool PY_BATCH_DISPATCH = false;
 
 void PyStart(void) {
   if (!PY_INTERP_INIT) {
@@ -60,6 +63,11 @@ void PyDelAgent(int i) {
   py_del_agent(i);
 };
 
+std::vector<int> PyCallAgents(std::string method, const std::vector<int>& ids) {
+  import_pymodule();
+  return py_call_agents(method, ids);
+};
+
 namespace toolkit {
 std::string PyToJson(std::string infile) {
   import_pyinfile();
@@ -85,6 +93,9 @@ void PyCallListeners(std::string tstype, Agent* agent, void* cpp_ctx, int time,
 namespace cyclus {
 int PY_INTERP_COUNT = 0;
 bool PY_INTERP_INIT = false;
+int PY_EVENT_LOOP_INTERVAL = 1;
+bool PY_EVENT_LOOP_ATTACHED = false;
+bool PY_BATCH_DISPATCH = false;
 
 void PyStart(void) {};
 
@@ -106,6 +117,10 @@ void ClearPyAgentRefs(void) {};
 
 void PyDelAgent(int i) {};
 
+std::vector<int> PyCallAgents(std::string method, const std::vector<int>& ids) {
+  return ids;
+};
+
 namespace toolkit {
 std::string PyToJson(std::string infile) {
   throw cyclus::ValidationError(
@@ -2,6 +2,7 @@
 #define CYCLUS_SRC_PYHOOKS_H_
 
 #include <string>
+#include <vector>
 
 #include "any.hpp"
 
@@ -16,6 +17,21 @@ extern int PY_INTERP_COUNT;
 /// Whether or not the Python interpreter has been initilized.
 extern bool PY_INTERP_INIT;
 
+/// The number of time steps between runs of the Python event loop (see
+/// EventLoop). It is 1 by default, i.e., the loop runs every time step. With
+/// 0, the loop only runs while a simulation state is attached to it (see
+/// PY_EVENT_LOOP_ATTACHED).
+extern int PY_EVENT_LOOP_INTERVAL;
+
+/// Whether a simulation state (e.g., of the cyclus server) is attached to
+/// the Python event loop. This is set from Python by cyclus.events.attach.
+extern bool PY_EVENT_LOOP_ATTACHED;
+
+/// Whether the timer ticks and tocks all Python agents with a single call
+/// into Python per phase (see PyCallAgents) rather than one call per agent.
+/// This is off by default.
+extern bool PY_BATCH_DISPATCH;
+
 /// Initialize Python functionality, this is a no-op if Python was not
 /// installed along with Cyclus. This may be called many times and safely
 /// initializes the Python interpreter only once.
@@ -44,6 +60,13 @@ void ClearPyAgentRefs(void);
 /// Removes a single Python agent from the reference cache.
 void PyDelAgent(int);
 
+/// Calls a phase ("tick" or "tock") of the Python agents with the given ids,
+/// in order, with a single call into Python. Each agent is called through its
+/// C++ shim, so the phase logic of its C++ base class runs as well. Returns
+/// the ids that do not belong to Python agents, which are left to the caller.
+/// Without Python, all ids are returned.
+std::vector<int> PyCallAgents(std::string method, const std::vector<int>& ids);
+
 namespace toolkit {
 enum TimeSeriesType : int;
 /// Convert Python simulation string to JSON
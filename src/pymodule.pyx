@@ -2,6 +2,7 @@
 from __future__ import print_function, unicode_literals
 from libcpp.cast cimport reinterpret_cast, dynamic_cast
 from libcpp.string cimport string as std_string
+from libcpp.vector cimport vector as std_vector
 from cpython.exc cimport PyErr_CheckSignals
 from cpython.pycapsule cimport PyCapsule_New, PyCapsule_GetPointer
 
@@ -96,3 +97,14 @@ cdef public api void py_call_listeners "CyclusPyCallListeners" (std_string cpp_t
     py_value = ts.capsule_any_to_py(value)
     cyclib.call_listeners(py_tsname, py_agent, time, py_value)
     PyErr_CheckSignals()
+
+
+cdef public api std_vector[int] py_call_agents "CyclusPyCallAgents" (std_string cpp_method,
+                                                              std_vector[int] cpp_ids) except *:
+    """Calls a method of many Python agents at once, returns the ids of the
+    agents that are not Python agents.
+    """
+    method = std_string_to_py(cpp_method)
+    cdef std_vector[int] rtn = cyclib.call_agents(method, cpp_ids)
+    PyErr_CheckSignals()
+    return rtn
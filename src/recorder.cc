@@ -3,6 +3,7 @@
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/lexical_cast.hpp>
+#include <utility>
 
 #include "datum.h"
 #include "logger.h"
@@ -10,24 +11,25 @@
 
 namespace cyclus {
 
-Recorder::Recorder() : index_(0), inject_sim_id_(true) {
+Recorder::Recorder() : index_(0), inject_sim_id_(true), nslots_(0) {
   uuid_ = boost::uuids::random_generator()();
   set_dump_count(kDefaultDumpCount);
 }
 
 Recorder::Recorder(bool inject_sim_id)
-    : index_(0), inject_sim_id_(inject_sim_id) {
+    : index_(0), inject_sim_id_(inject_sim_id), nslots_(0) {
   uuid_ = boost::uuids::random_generator()();
   set_dump_count(kDefaultDumpCount);
 }
 
-Recorder::Recorder(unsigned int dump_count) : index_(0), inject_sim_id_(true) {
+Recorder::Recorder(unsigned int dump_count)
+    : index_(0), inject_sim_id_(true), nslots_(0) {
   uuid_ = boost::uuids::random_generator()();
   set_dump_count(dump_count);
 }
 
 Recorder::Recorder(boost::uuids::uuid simid)
-    : index_(0), uuid_(simid), inject_sim_id_(true) {
+    : index_(0), uuid_(simid), inject_sim_id_(true), nslots_(0) {
   set_dump_count(kDefaultDumpCount);
 }
 
@@ -41,6 +43,11 @@ Recorder::~Recorder() {
   for (int i = 0; i < data_.size(); ++i) {
     delete data_[i];
   }
+  for (int i = 0; i < slot_data_.size(); ++i) {
+    for (int j = 0; j < slot_data_[i].size(); ++j) {
+      delete slot_data_[i][j];
+    }
+  }
 }
 
 unsigned int Recorder::dump_count() {
@@ -56,6 +63,12 @@ void Recorder::set_dump_count(unsigned int count) {
     delete data_[i];
   }
   data_.clear();
+  for (int i = 0; i < slot_data_.size(); ++i) {
+    for (int j = 0; j < slot_data_[i].size(); ++j) {
+      delete slot_data_[i][j];
+    }
+  }
+  slot_data_.clear();
   data_.reserve(count);
   for (int i = 0; i < count; ++i) {
     Datum* d = new Datum(this, "");
@@ -68,7 +81,27 @@ void Recorder::set_dump_count(unsigned int count) {
 }
 
 Datum* Recorder::NewDatum(std::string title) {
-  Datum* d = data_[index_];
+  int slot = ParallelIdPhase::slot();
+  if (slot >= 0 && slot < nslots_) {
+    // only the thread bound to the slot touches its buffer
+    DatumList& data = slot_data_[slot];
+    int& n = slot_counts_[slot];
+    if (n == data.size()) {
+      Datum* d = new Datum(this, "");
+      if (inject_sim_id_) {
+        d->AddVal("SimId", uuid_);
+      }
+      data.push_back(d);
+    }
+    return ResetDatum(data[n++], title);
+  }
+
+  Datum* d = ResetDatum(data_[index_], title);
+  index_++;
+  return d;
+}
+
+Datum* Recorder::ResetDatum(Datum* d, const std::string& title) {
   d->title_ = title;
   if (inject_sim_id_) {
     d->vals_.resize(1);
@@ -79,12 +112,36 @@ Datum* Recorder::NewDatum(std::string title) {
     d->shapes_.resize(0);
     d->fields_.resize(0);
   }
-
-  index_++;
   return d;
 }
 
+void Recorder::BeginPhase(int nslots) {
+  if (slot_data_.size() < nslots) {
+    slot_data_.resize(nslots);
+  }
+  slot_counts_.assign(nslots, 0);
+  nslots_ = nslots;
+}
+
+void Recorder::EndPhase() {
+  nslots_ = 0;
+  for (int i = 0; i < slot_counts_.size(); ++i) {
+    DatumList& data = slot_data_[i];
+    for (int j = 0; j < slot_counts_[i]; ++j) {
+      // swap rather than copy, the replaced Datum is reused by the slot
+      std::swap(data_[index_], data[j]);
+      index_++;
+      AddDatum(data_[index_ - 1]);
+    }
+  }
+  slot_counts_.clear();
+}
+
 void Recorder::AddDatum(Datum* d) {
+  int slot = ParallelIdPhase::slot();
+  if (slot >= 0 && slot < nslots_) {
+    return;  // kept in the slot's buffer until the phase ends
+  }
   if (index_ >= data_.size()) {
     NotifyBackends();
   }
@@ -8,6 +8,7 @@
 #include <boost/uuid/uuid_io.hpp>
 
 #include "error.h"
+#include "id_allocator.h"
 
 namespace cyclus {
 
@@ -42,7 +43,12 @@ static unsigned int const kDefaultDumpCount = 10000;
 /// manager->Close();
 ///
 /// @endcode
-class Recorder {
+///
+/// Within the slots of a parallel id phase (see ParallelIdPhase), e.g. while
+/// agents tick or trade concurrently, each slot records into its own buffer.
+/// The buffers are merged in slot order when the phase ends, so that the
+/// output does not depend on thread scheduling.
+class Recorder : public PhaseListener {
   friend class Datum;
 
  public:
@@ -114,10 +120,24 @@ class Recorder {
   /// Unregisters all backends and resets.
   void Close();
 
+  virtual void BeginPhase(int nslots);
+
+  /// merges the Datum objects recorded by each slot in slot order
+  virtual void EndPhase();
+
  private:
   void NotifyBackends();
   void AddDatum(Datum* d);
 
+  /// clears d for reuse under the given title
+  Datum* ResetDatum(Datum* d, const std::string& title);
+
+  /// the Datum objects of each slot of the current phase, only the first
+  /// slot_counts_[i] of slot i are in use
+  std::vector<DatumList> slot_data_;
+  std::vector<int> slot_counts_;
+  int nslots_;
+
   DatumList data_;
   int index_;
   std::list<RecBackend*> backs_;
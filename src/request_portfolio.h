@@ -13,6 +13,7 @@
 #include "capacity_constraint.h"
 #include "error.h"
 #include "logger.h"
+#include "pool_base.h"
 #include "request.h"
 
 namespace cyclus {
@@ -84,7 +85,8 @@ template <class T> struct QtyCoeffConverter : public Converter<T> {
 /// coefficient of 9.5 / 9.
 template <class T>
 class RequestPortfolio
-    : public boost::enable_shared_from_this<RequestPortfolio<T>> {
+    : public boost::enable_shared_from_this<RequestPortfolio<T>>,
+      public PoolBase<RequestPortfolio<T>> {
  public:
   typedef boost::shared_ptr<RequestPortfolio<T>> Ptr;
   typedef std::function<double(boost::shared_ptr<T>)> cost_function_t;
@@ -2,12 +2,11 @@
 
 namespace cyclus {
 
-int Resource::nextstate_id_ = 1;
-int Resource::nextobj_id_ = 1;
+IdAllocator Resource::nextstate_id_(1);
+IdAllocator Resource::nextobj_id_(1);
 
 void Resource::BumpStateId() {
-  state_id_ = nextstate_id_;
-  nextstate_id_++;
+  state_id_ = nextstate_id_.Next();
 }
 
 }  // namespace cyclus
@@ -2,11 +2,13 @@
 #define CYCLUS_SRC_RESOURCE_H_
 
 #include <string>
+#include <typeinfo>
 #include <vector>
 #include <boost/shared_ptr.hpp>
 
 #include "package.h"
 #include "cyc_limits.h"
+#include "id_allocator.h"
 
 class SimInitTest;
 
@@ -26,7 +28,7 @@ class Resource {
  public:
   typedef boost::shared_ptr<Resource> Ptr;
 
-  Resource() : state_id_(nextstate_id_++), obj_id_(nextobj_id_++) {}
+  Resource() : state_id_(nextstate_id_.Next()), obj_id_(nextobj_id_.Next()) {}
 
   virtual ~Resource() {}
 
@@ -109,8 +111,8 @@ class Resource {
   template <class T> std::vector<typename T::Ptr> Package(Package::Ptr pkg);
 
  private:
-  static int nextstate_id_;
-  static int nextobj_id_;
+  static IdAllocator nextstate_id_;
+  static IdAllocator nextobj_id_;
   int state_id_;
   // Setting the state id should only be done when extracting one resource
   void state_id(int st_id) { state_id_ = st_id; }
@@ -118,21 +120,28 @@ class Resource {
   int obj_id_;
 };
 
+/// Casts a Resource::Ptr into a pointer of a specific resource type T.
+/// Returns a NULL pointer if r is not a T.  The common case of r's dynamic
+/// type being exactly T is detected with a type tag (typeid) comparison and a
+/// static cast, only falling back to a full dynamic cast otherwise.
+template <class T> typename T::Ptr ResCast(const Resource::Ptr& r) {
+  if (r != NULL && typeid(*r) == typeid(T)) {
+    return boost::static_pointer_cast<T>(r);
+  }
+  return boost::dynamic_pointer_cast<T>(r);
+}
+
 /// Casts a vector of Resources into a vector of a specific resource type T.
 template <class T>
-std::vector<typename T::Ptr> ResCast(std::vector<Resource::Ptr> rs) {
+std::vector<typename T::Ptr> ResCast(const std::vector<Resource::Ptr>& rs) {
   std::vector<typename T::Ptr> casted;
+  casted.reserve(rs.size());
   for (int i = 0; i < rs.size(); ++i) {
-    casted.push_back(boost::dynamic_pointer_cast<T>(rs[i]));
+    casted.push_back(ResCast<T>(rs[i]));
   }
   return casted;
 }
 
-/// Casts a Resource::Ptr into a pointer of a specific resource type T.
-template <class T> typename T::Ptr ResCast(Resource::Ptr r) {
-  return boost::dynamic_pointer_cast<T>(r);
-}
-
 template <class T>
 std::vector<typename T::Ptr> Resource::Package(Package::Ptr pkg) {
   std::vector<typename T::Ptr> ts_pkgd;
@@ -145,8 +154,7 @@ std::vector<typename T::Ptr> Resource::Package(Package::Ptr pkg) {
 
   for (int i = 0; i < packages.size(); ++i) {
     double pkg_fill = packages[i];
-    t_pkgd =
-        boost::dynamic_pointer_cast<T>(PackageExtract(pkg_fill, pkg->name()));
+    t_pkgd = ResCast<T>(PackageExtract(pkg_fill, pkg->name()));
     ts_pkgd.push_back(t_pkgd);
   }
 
@@ -2,8 +2,11 @@
 #define CYCLUS_SRC_RESOURCE_EXCHANGE_H_
 
 #include <algorithm>
-#include <functional>
+#include <map>
 #include <set>
+#include <typeindex>
+#include <typeinfo>
+#include <vector>
 
 #include "bid_portfolio.h"
 #include "context.h"
@@ -57,6 +60,12 @@ inline static void AdjustPrefs(Trader* t, PrefMap<Product>::type& prefs) {
 /// exchng.AddAllBids();
 /// exchng.AdjustAll();
 /// @endcode
+///
+/// If Cyclus is built with OpenMP, traders whose agents opt into concurrent
+/// execution (TimeListeners that are not shims, see Timer) are queried
+/// concurrently in each phase. All other traders are queried from the calling
+/// thread. Results are always merged into the ExchangeContext in the same
+/// (deterministic) trader order, independent of the number of threads.
 template <class T> class ResourceExchange {
  public:
   /// @brief default constructor
@@ -69,32 +78,66 @@ template <class T> class ResourceExchange {
   /// @brief queries traders and collects all requests for bids
   void AddAllRequests() {
     InitTraders();
-    std::for_each(traders_.begin(),
-                  traders_.end(),
-                  std::bind(&cyclus::ResourceExchange<T>::AddRequests_,
-                            this,
-                            std::placeholders::_1));
+    std::vector<Trader*> traders(traders_.begin(), traders_.end());
+    std::vector<std::set<typename RequestPortfolio<T>::Ptr>> rps(
+        traders.size());
+    ForEachTrader(traders, false, [&](int i) {
+      rps[i] = QueryRequests<T>(traders[i]);
+    });
+    for (int i = 0; i < rps.size(); ++i) {
+      AddRequests_(rps[i]);
+    }
   }
 
   /// @brief queries traders and collects all responses to requests for bids
   void AddAllBids() {
     InitTraders();
-    std::for_each(traders_.begin(),
-                  traders_.end(),
-                  std::bind(&cyclus::ResourceExchange<T>::AddBids_,
-                            this,
-                            std::placeholders::_1));
+    std::vector<Trader*> traders(traders_.begin(), traders_.end());
+    std::vector<std::set<typename BidPortfolio<T>::Ptr>> bps(traders.size());
+    ForEachTrader(traders, false, [&](int i) {
+      bps[i] = QueryBids<T>(traders[i], ex_ctx_.commod_requests);
+    });
+    for (int i = 0; i < bps.size(); ++i) {
+      AddBids_(bps[i]);
+    }
   }
 
   /// @brief adjust preferences for requests given bid responses
+  ///
+  /// Requesters are only asked to adjust preferences if they or one of their
+  /// parents may override the default adjustment, i.e., if one of their agent
+  /// types has not yet been seen to keep it (see DefaultPrefs). Only these
+  /// requesters get their nested preferences built in the ExchangeContext.
   void AdjustAll() {
     InitTraders();
-    std::set<Trader*> traders = ex_ctx_.requesters;
-    std::for_each(traders.begin(),
-                  traders.end(),
-                  std::bind(&cyclus::ResourceExchange<T>::AdjustPrefs_,
-                            this,
-                            std::placeholders::_1));
+    std::set<Trader*, trader_compare> requesters(ex_ctx_.requesters.begin(),
+                                                 ex_ctx_.requesters.end());
+    std::vector<Trader*> traders;
+    std::set<Trader*> adjusting;
+    typename std::set<Trader*, trader_compare>::iterator it;
+    for (it = requesters.begin(); it != requesters.end(); ++it) {
+      if (MayAdjust_(*it)) {
+        traders.push_back(*it);
+        adjusting.insert(*it);
+      }
+    }
+
+    // each requester only touches its own preferences, which are created up
+    // front so that the preference map is not modified concurrently
+    ex_ctx_.BuildPrefs(adjusting);
+    std::vector<typename PrefMap<T>::type*> prefs;
+    for (int i = 0; i < traders.size(); ++i) {
+      prefs.push_back(&ex_ctx_.trader_prefs[traders[i]]);
+    }
+    std::vector<std::vector<bool>> defaults(traders.size());
+    ForEachTrader(traders, true, [&](int i) {
+      defaults[i] = AdjustPrefs_(traders[i], *prefs[i]);
+    });
+
+    for (int i = 0; i < traders.size(); ++i) {
+      Learn_(traders[i], defaults[i]);
+    }
+    ex_ctx_.FlattenPrefs();
   }
 
   /// return true if this is an empty exchange (i.e., no requests exist,
@@ -112,20 +155,17 @@ template <class T> class ResourceExchange {
     }
   }
 
-  /// @brief queries a given facility agent for
-  void AddRequests_(Trader* t) {
-    std::set<typename RequestPortfolio<T>::Ptr> rp = QueryRequests<T>(t);
-    typename std::set<typename RequestPortfolio<T>::Ptr>::iterator it;
+  /// @brief adds a trader's request portfolios to the exchange
+  void AddRequests_(const std::set<typename RequestPortfolio<T>::Ptr>& rp) {
+    typename std::set<typename RequestPortfolio<T>::Ptr>::const_iterator it;
     for (it = rp.begin(); it != rp.end(); ++it) {
       ex_ctx_.AddRequestPortfolio(*it);
     }
   }
 
-  /// @brief queries a given facility agent for
-  void AddBids_(Trader* t) {
-    std::set<typename BidPortfolio<T>::Ptr> bp =
-        QueryBids<T>(t, ex_ctx_.commod_requests);
-    typename std::set<typename BidPortfolio<T>::Ptr>::iterator it;
+  /// @brief adds a trader's bid portfolios to the exchange
+  void AddBids_(const std::set<typename BidPortfolio<T>::Ptr>& bp) {
+    typename std::set<typename BidPortfolio<T>::Ptr>::const_iterator it;
     for (it = bp.begin(); it != bp.end(); ++it) {
       ex_ctx_.AddBidPortfolio(*it);
     }
@@ -133,14 +173,55 @@ template <class T> class ResourceExchange {
 
   /// @brief allows a trader and its parents to adjust any preferences in the
   /// system
-  void AdjustPrefs_(Trader* t) {
-    typename PrefMap<T>::type& prefs = ex_ctx_.trader_prefs[t];
+  /// @return whether each call, in order from the trader up to its top-level
+  /// parent, reached the default adjustment
+  std::vector<bool> AdjustPrefs_(Trader* t, typename PrefMap<T>::type& prefs) {
+    std::vector<bool> defaults;
+    DefaultPrefs::Take();
     AdjustPrefs(t, prefs);
+    defaults.push_back(DefaultPrefs::Take());
     Agent* m = t->manager()->parent();
     while (m != NULL) {
       AdjustPrefs(m, prefs);
+      defaults.push_back(DefaultPrefs::Take());
       m = m->parent();
     }
+    return defaults;
+  }
+
+  /// @return false if the trader and all of its parents are of agent types
+  /// known to keep the default preference adjustment
+  bool MayAdjust_(Trader* t) {
+    std::map<std::type_index, bool>& adjusts = Adjusts_();
+    std::map<std::type_index, bool>::iterator it = adjusts.find(typeid(*t));
+    if (it == adjusts.end() || it->second) {
+      return true;
+    }
+    for (Agent* m = t->manager()->parent(); m != NULL; m = m->parent()) {
+      it = adjusts.find(typeid(*m));
+      if (it == adjusts.end() || it->second) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /// @brief records which agent types of a trader and its parents kept the
+  /// default preference adjustment, see AdjustPrefs_
+  void Learn_(Trader* t, const std::vector<bool>& defaults) {
+    std::map<std::type_index, bool>& adjusts = Adjusts_();
+    adjusts[typeid(*t)] |= !defaults[0];
+    int i = 1;
+    for (Agent* m = t->manager()->parent(); m != NULL; m = m->parent()) {
+      adjusts[typeid(*m)] |= !defaults[i++];
+    }
+  }
+
+  /// @brief whether agent types adjust preferences of this resource type,
+  /// shared by all exchanges
+  static std::map<std::type_index, bool>& Adjusts_() {
+    static std::map<std::type_index, bool> adjusts;
+    return adjusts;
   }
 
   struct trader_compare {
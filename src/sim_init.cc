@@ -2,6 +2,7 @@
 
 #include "greedy_preconditioner.h"
 #include "greedy_solver.h"
+#include "min_cost_flow_solver.h"
 #include "platform.h"
 #include "prog_solver.h"
 #include "region.h"
@@ -102,17 +103,17 @@ void SimInit::Snapshot(Context* ctx) {
   ctx->NewDatum("NextIds")
       ->AddVal("Time", ctx->time())
       ->AddVal("Object", std::string("Composition"))
-      ->AddVal("NextId", Composition::next_id_)
+      ->AddVal("NextId", Composition::next_id_.next())
       ->Record();
   ctx->NewDatum("NextIds")
       ->AddVal("Time", ctx->time())
       ->AddVal("Object", std::string("ResourceState"))
-      ->AddVal("NextId", Resource::nextstate_id_)
+      ->AddVal("NextId", Resource::nextstate_id_.next())
       ->Record();
   ctx->NewDatum("NextIds")
       ->AddVal("Time", ctx->time())
       ->AddVal("Object", std::string("ResourceObj"))
-      ->AddVal("NextId", Resource::nextobj_id_)
+      ->AddVal("NextId", Resource::nextobj_id_.next())
       ->Record();
   ctx->NewDatum("NextIds")
       ->AddVal("Time", ctx->time())
@@ -173,6 +174,18 @@ void SimInit::LoadInfo() {
   si_.explicit_inventory = qr.GetVal<bool>("RecordInventory");
   si_.explicit_inventory_compact = qr.GetVal<bool>("RecordInventoryCompact");
 
+  try {
+    qr = b_->Query("InfoDecayChains", NULL);
+    si_.compact_decay_chains = qr.GetVal<bool>("CompactDecayChains");
+  } catch (std::exception err) {
+  }  // table doesn't exist (okay)
+
+  try {
+    qr = b_->Query("InfoFastForward", NULL);
+    si_.fast_forward = qr.GetVal<bool>("FastForward");
+  } catch (std::exception err) {
+  }  // table doesn't exist (okay)
+
   ctx_->InitSim(si_);
 }
 
@@ -297,6 +310,9 @@ ExchangeSolver* SimInit::LoadCoinSolver(
   ExchangeSolver* solver;
   double timeout;
   bool verbose, mps;
+  bool warm_start = false;
+  bool greedy_start = true;
+  bool relax_and_round = false;
 
   std::string solver_info = "CoinSolverInfo";
   if (0 < tables.count(solver_info)) {
@@ -304,11 +320,21 @@ ExchangeSolver* SimInit::LoadCoinSolver(
     timeout = qr.GetVal<double>("Timeout");
     verbose = qr.GetVal<bool>("Verbose");
     mps = qr.GetVal<bool>("Mps");
+    try {
+      warm_start = qr.GetVal<bool>("WarmStart");
+      greedy_start = qr.GetVal<bool>("GreedyStart");
+      relax_and_round = qr.GetVal<bool>("RelaxAndRound");
+    } catch (std::exception err) {
+    }  // column doesn't exist in older databases (okay)
   }
 
   // set timeout to default if input value is non-positive
   timeout = timeout <= 0 ? ProgSolver::kDefaultTimeout : timeout;
-  solver = new ProgSolver("cbc", timeout, exclusive, verbose, mps);
+  ProgSolver* prog = new ProgSolver("cbc", timeout, exclusive, verbose, mps);
+  prog->warm_start(warm_start);
+  prog->greedy_start(greedy_start);
+  prog->relax_and_round(relax_and_round);
+  solver = prog;
   return solver;
 #else
   throw cyclus::Error(
@@ -316,6 +342,17 @@ ExchangeSolver* SimInit::LoadCoinSolver(
 #endif
 }
 
+ExchangeSolver* SimInit::LoadMinCostFlowSolver(
+    bool exclusive, std::set<std::string> tables) {
+  // exchanges with exclusive orders are handed to the fallback solver
+#if CYCLUS_HAS_COIN
+  ExchangeSolver* fallback = LoadCoinSolver(exclusive, tables);
+#else
+  ExchangeSolver* fallback = LoadGreedySolver(exclusive, tables);
+#endif
+  return new MinCostFlowSolver(exclusive, fallback);
+}
+
 void SimInit::LoadSolverInfo() {
   using std::set;
   using std::string;
@@ -340,6 +377,8 @@ void SimInit::LoadSolverInfo() {
     solver = LoadGreedySolver(exclusive_orders, tables);
   } else if (solver_name == "coin-or") {
     solver = LoadCoinSolver(exclusive_orders, tables);
+  } else if (solver_name == "min-cost-flow") {
+    solver = LoadMinCostFlowSolver(exclusive_orders, tables);
   } else {
     throw ValueError(
         "The name of the solver was not recognized, "
@@ -536,11 +575,11 @@ void SimInit::LoadNextIds() {
     } else if (obj == "Transaction") {
       ctx_->trans_id_ = qr.GetVal<int>("NextId", i);
     } else if (obj == "Composition") {
-      Composition::next_id_ = qr.GetVal<int>("NextId", i);
+      Composition::next_id_.Reset(qr.GetVal<int>("NextId", i));
     } else if (obj == "ResourceState") {
-      Resource::nextstate_id_ = qr.GetVal<int>("NextId", i);
+      Resource::nextstate_id_.Reset(qr.GetVal<int>("NextId", i));
     } else if (obj == "ResourceObj") {
-      Resource::nextobj_id_ = qr.GetVal<int>("NextId", i);
+      Resource::nextobj_id_.Reset(qr.GetVal<int>("NextId", i));
     } else if (obj == "Product") {
       Product::next_qualid_ = qr.GetVal<int>("NextId", i);
     } else {
@@ -577,6 +616,10 @@ Product::Ptr SimInit::BuildProduct(QueryableBackend* b, int resid) {
   return p;
 }
 
+Composition::Ptr SimInit::BuildComposition(QueryableBackend* b, int qualid) {
+  return LoadComposition(b, qualid);
+}
+
 Resource::Ptr SimInit::LoadResource(Context* ctx, QueryableBackend* b,
                                     int state_id) {
   std::vector<Cond> conds;
@@ -628,6 +671,13 @@ Composition::Ptr SimInit::LoadComposition(QueryableBackend* b, int stateid) {
   std::vector<Cond> conds;
   conds.push_back(Cond("QualId", "==", stateid));
   QueryResult qr = b->Query("Compositions", &conds);
+  if (qr.rows.size() == 0) {
+    Composition::Ptr c = LoadDecayedComposition(b, stateid);
+    if (c != NULL) {
+      return c;
+    }
+  }
+
   CompMap cm;
   for (int i = 0; i < qr.rows.size(); ++i) {
     int nucid = qr.GetVal<int>("NucId", i);
@@ -640,6 +690,34 @@ Composition::Ptr SimInit::LoadComposition(QueryableBackend* b, int stateid) {
   return c;
 }
 
+Composition::Ptr SimInit::LoadDecayedComposition(QueryableBackend* b,
+                                                 int stateid) {
+  std::vector<Cond> conds;
+  conds.push_back(Cond("QualId", "==", stateid));
+  QueryResult qr;
+  try {
+    qr = b->Query("DecayedCompositions", &conds);
+  } catch (std::exception err) {
+    return Composition::Ptr();
+  }  // table doesn't exist (okay)
+  if (qr.rows.size() == 0) {
+    return Composition::Ptr();
+  }
+
+  int parentid = qr.GetVal<int>("ParentQualId");
+  int delta = qr.GetVal<int>("DecayTime");
+  // TODO: when the backends support uint64_t, the int template here
+  // should be updated to uint64_t.
+  uint64_t secs_per_timestep = qr.GetVal<int>("TimeStepDur");
+
+  // materialize the full composition by rerunning the same decay calculation
+  Composition::Ptr parent = LoadComposition(b, parentid);
+  Composition::Ptr c = parent->Decay(delta, secs_per_timestep);
+  c->recorded_ = true;
+  c->id_ = stateid;
+  return c;
+}
+
 Product::Ptr SimInit::LoadProduct(Context* ctx, QueryableBackend* b,
                                   int state_id) {
   // get general resource object info
@@ -75,6 +75,12 @@ class SimInit {
   /// useful for running mock simulations/tests.
   static Product::Ptr BuildProduct(QueryableBackend* b, int resid);
 
+  /// Convenience function for reconstructing the composition with the given
+  /// quality id from a database backend b.  Compositions that were recorded
+  /// compactly in the DecayedCompositions table are materialized by decaying
+  /// their (recursively reconstructed) parent composition.
+  static Composition::Ptr BuildComposition(QueryableBackend* b, int qualid);
+
  private:
   void InitBase(QueryableBackend* b, boost::uuids::uuid simid, int t);
 
@@ -94,12 +100,16 @@ class SimInit {
   ExchangeSolver* LoadGreedySolver(bool exclusive,
                                    std::set<std::string> tables);
   ExchangeSolver* LoadCoinSolver(bool exclusive, std::set<std::string> tables);
+  ExchangeSolver* LoadMinCostFlowSolver(bool exclusive,
+                                        std::set<std::string> tables);
   static Resource::Ptr LoadResource(Context* ctx, QueryableBackend* b,
                                     int resid);
   static Material::Ptr LoadMaterial(Context* ctx, QueryableBackend* b,
                                     int resid);
   static Product::Ptr LoadProduct(Context* ctx, QueryableBackend* b, int resid);
   static Composition::Ptr LoadComposition(QueryableBackend* b, int stateid);
+  static Composition::Ptr LoadDecayedComposition(QueryableBackend* b,
+                                                 int stateid);
 
   // std::map<AgentId, Agent*>
   std::map<int, Agent*> agents_;
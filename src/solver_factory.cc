@@ -6,6 +6,7 @@
 #include "OsiCbcSolverInterface.hpp"
 #include "CbcSolver.hpp"
 #include "CoinTime.hpp"
+#include "CoinWarmStartBasis.hpp"
 
 #include "error.h"
 
@@ -111,14 +112,28 @@ void ReportProg(OsiSolverInterface* si) {
 }
 
 void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose) {
+  SolveProg(si, greedy_obj, verbose, NULL, NULL);
+}
+
+bool SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose,
+               const double* start, const CoinWarmStart* basis) {
   if (verbose) ReportProg(si);
 
+  bool warm = false;
   if (HasInt(si)) {
     CbcModel model(*si);
     ObjValueHandler handler(greedy_obj);
     model.passInEventHandler(&handler);
     model.setLogLevel(0);
     model.initialSolve();
+    if (start != NULL) {
+      const double* objs = si->getObjCoefficients();
+      double obj = 0;
+      for (int i = 0; i != si->getNumCols(); i++) {
+        obj += objs[i] * start[i];
+      }
+      model.setBestSolution(start, si->getNumCols(), obj, true);
+    }
     model.branchAndBound();
     si->setColSolution(model.bestSolution());
     if (verbose) {
@@ -126,6 +141,9 @@ void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose) {
                 << handler.obj() << " and found " << std::boolalpha
                 << handler.found() << "\n";
     }
+  } else if (BasisFits(basis, si) && si->setWarmStart(basis)) {
+    si->resolve();
+    warm = true;
   } else {
     // no ints, just solve 'initial lp relaxation'
     si->initialSolve();
@@ -138,6 +156,7 @@ void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose) {
                 << " integer: " << std::boolalpha << si->isInteger(i) << "\n";
     }
   }
+  return warm;
 }
 
 void SolveProg(OsiSolverInterface* si) {
@@ -162,4 +181,10 @@ bool HasInt(OsiSolverInterface* si) {
   return false;
 }
 
+bool BasisFits(const CoinWarmStart* basis, OsiSolverInterface* si) {
+  const CoinWarmStartBasis* b = dynamic_cast<const CoinWarmStartBasis*>(basis);
+  return b != NULL && b->getNumStructural() == si->getNumCols() &&
+         b->getNumArtificial() == si->getNumRows();
+}
+
 }  // namespace cyclus
@@ -7,6 +7,7 @@
 
 #include "CbcEventHandler.hpp"
 
+class CoinWarmStart;
 class OsiSolverInterface;
 
 namespace cyclus {
@@ -64,8 +65,22 @@ void SolveProg(OsiSolverInterface* si);
 void SolveProg(OsiSolverInterface* si, bool verbose);
 void SolveProg(OsiSolverInterface* si, double greedy_obj);
 void SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose);
+
+/// @brief solves a program, optionally warm started
+/// @param start a full column solution offered to Cbc as the initial
+/// incumbent (it is discarded if infeasible), or NULL
+/// @param basis a basis from which linear programs are resolved instead of
+/// solved from scratch, or NULL. It is only used if it has a status for each
+/// column and row of the program.
+/// @return true if the program was resolved from basis
+bool SolveProg(OsiSolverInterface* si, double greedy_obj, bool verbose,
+               const double* start, const CoinWarmStart* basis);
 bool HasInt(OsiSolverInterface* si);
 
+/// @return true if basis is a CoinWarmStartBasis with a status for each column
+/// and row of the program loaded in si (false if basis is NULL)
+bool BasisFits(const CoinWarmStart* basis, OsiSolverInterface* si);
+
 }  // namespace cyclus
 
 #endif  // CYCLUS_HAS_COIN
@@ -0,0 +1,102 @@
+#include "task_scheduler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <exception>
+#include <limits>
+
+#include "error.h"
+#include "platform.h"
+
+namespace cyclus {
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+/// orders tasks by descending expected cost, ties by index
+struct CostComp {
+  explicit CostComp(const std::vector<double>& costs) : costs(costs) {}
+
+  bool operator()(int l, int r) const {
+    return costs[l] != costs[r] ? costs[l] > costs[r] : l < r;
+  }
+
+  const std::vector<double>& costs;
+};
+
+}  // namespace
+
+TaskScheduler::TaskScheduler(double weight) : weight_(weight) {
+  if (weight <= 0 || weight > 1) {
+    throw ValueError("TaskScheduler weight must be in (0, 1]");
+  }
+}
+
+double TaskScheduler::cost(int key) const {
+  std::unordered_map<int, double>::const_iterator it = costs_.find(key);
+  return it == costs_.end() ? -1 : it->second;
+}
+
+void TaskScheduler::Run(const std::vector<int>& keys,
+                        const std::function<void(int)>& f,
+                        const std::function<void()>& serial) {
+  int n = keys.size();
+  times_.resize(n);
+#if CYCLUS_IS_PARALLEL
+  // longest expected tasks first, unknown tasks before all others
+  order_.resize(n);
+  for (int i = 0; i < n; ++i) {
+    order_[i] = i;
+    double c = cost(keys[i]);
+    times_[i] = c < 0 ? std::numeric_limits<double>::max() : c;
+  }
+  std::sort(order_.begin(), order_.end(), CostComp(times_));
+
+  // the serial task goes first, as in serial builds
+  if (serial) {
+    serial();
+  }
+
+  // exceptions may not escape a parallel region
+  std::vector<std::exception_ptr> errors(n);
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int k = 0; k < n; ++k) {
+    int i = order_[k];
+    Clock::time_point start = Clock::now();
+    try {
+      f(i);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+    times_[i] = std::chrono::duration<double>(Clock::now() - start).count();
+  }
+
+  for (int i = 0; i < n; ++i) {
+    if (errors[i]) {
+      std::rethrow_exception(errors[i]);
+    }
+  }
+#else
+  // in order, so that serial simulations are unaffected by timing
+  if (serial) {
+    serial();
+  }
+  for (int i = 0; i < n; ++i) {
+    Clock::time_point start = Clock::now();
+    f(i);
+    times_[i] = std::chrono::duration<double>(Clock::now() - start).count();
+  }
+#endif  // CYCLUS_IS_PARALLEL
+
+  for (int i = 0; i < n; ++i) {
+    std::unordered_map<int, double>::iterator it = costs_.find(keys[i]);
+    if (it == costs_.end()) {
+      costs_[keys[i]] = times_[i];
+    } else {
+      it->second = weight_ * times_[i] + (1 - weight_) * it->second;
+    }
+  }
+}
+
+}  // namespace cyclus
@@ -0,0 +1,66 @@
+#ifndef CYCLUS_SRC_TASK_SCHEDULER_H_
+#define CYCLUS_SRC_TASK_SCHEDULER_H_
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace cyclus {
+
+/// @brief The TaskScheduler runs batches of independent tasks, such as the
+/// Tick of every agent, balancing their load across threads.
+///
+/// Each task is identified across batches by a stable key (e.g., an agent
+/// id). The scheduler measures the wall time of every task and keeps an
+/// exponential moving average of its cost. Each batch is then handed out one
+/// task at a time in order of descending expected cost (longest processing
+/// time first), so that a few expensive tasks start early and the cheap ones
+/// fill the gaps, much like work stealing. Tasks without any history are
+/// assumed to be expensive.
+///
+/// An optional serial task is run on the calling thread before the batch.
+/// This is used for Python agents, which must run on the thread holding the
+/// interpreter. Running it first rather than alongside the batch keeps the
+/// order of the serial task and the batch the same with and without OpenMP.
+///
+/// The order in which the tasks of a batch run does not affect which ids
+/// they are handed or the order of their recorded output (see
+/// ParallelIdPhase). As long as the tasks of a batch do not depend on each
+/// other, scheduling therefore does not change simulation results.
+/// If Cyclus is not built with OpenMP, all tasks are run in order on the
+/// calling thread.
+class TaskScheduler {
+ public:
+  /// @param weight the weight of the latest measurement in the moving
+  /// average of a task's cost, in (0, 1]
+  explicit TaskScheduler(double weight = 0.5);
+
+  /// @brief runs f(i) for each task i and the serial task
+  ///
+  /// Exceptions thrown by tasks are rethrown after the whole batch is done,
+  /// the one of the task with the lowest index first.
+  ///
+  /// @param keys the key of each task
+  /// @param f runs task i
+  /// @param serial run on the calling thread, may be empty
+  void Run(const std::vector<int>& keys, const std::function<void(int)>& f,
+           const std::function<void()>& serial = std::function<void()>());
+
+  /// @return the expected cost (in seconds) of the task with the given key,
+  /// or a negative value if it has not run yet
+  double cost(int key) const;
+
+  /// @brief forgets all cost history
+  inline void Reset() { costs_.clear(); }
+
+ private:
+  double weight_;
+  std::unordered_map<int, double> costs_;
+  /// scratch space for the task order and the measured times
+  std::vector<int> order_;
+  std::vector<double> times_;
+};
+
+}  // namespace cyclus
+
+#endif  // CYCLUS_SRC_TASK_SCHEDULER_H_
@@ -8,6 +8,15 @@
 
 namespace cyclus {
 
+/// The time step phases a TimeListener may be notified of, see
+/// TimeListener::TimePhases
+enum TimePhase {
+  kTickPhase = 1,
+  kTockPhase = 2,
+  kDecisionPhase = 4,
+  kAllPhases = kTickPhase | kTockPhase | kDecisionPhase,
+};
+
 /// The TimeListener class is an inheritable class for any Agent that
 /// requires knowlege of ticks and tocks. The agent should register as a
 /// TimeListener with its context from its Deploy method. For Example:
@@ -44,6 +53,13 @@ class TimeListener : virtual public Ider {
   virtual void Decision() {};
 
   virtual bool IsShim() { return true; };
+
+  /// The phases the agent is notified of, as a bitwise or of TimePhase
+  /// values. It is queried once, when the agent registers, so agents that do
+  /// nothing in some phase (e.g., in Decision) can skip it altogether. Agents
+  /// that are idle for a while can additionally stop being notified until a
+  /// given time step, see Context::Sleep.
+  virtual int TimePhases() { return kAllPhases; }
 };
 
 }  // namespace cyclus
@@ -2,6 +2,7 @@
 // Implements the Timer class
 #include "timer.h"
 
+#include <algorithm>
 #include <iostream>
 #include <string>
 #if CYCLUS_IS_PARALLEL
@@ -10,9 +11,12 @@
 
 #include "agent.h"
 #include "error.h"
+#include "id_allocator.h"
 #include "logger.h"
+#include "profiler.h"
 #include "pyhooks.h"
 #include "sim_init.h"
+#include "trader.h"
 
 namespace cyclus {
 
@@ -23,6 +27,7 @@ void Timer::RunSim() {
 
   ExchangeManager<Material> matl_manager(ctx_);
   ExchangeManager<Product> genrsrc_manager(ctx_);
+  int steps = 0;
   while (time_ < si_.duration) {
     CLOG(LEV_INFO1) << "Current time: " << time_;
 
@@ -34,26 +39,42 @@ void Timer::RunSim() {
     // run through phases
     DoBuild();
     CLOG(LEV_INFO2) << "Beginning Tick for time: " << time_;
+    UpdateListeners();
     DoTick();
     CLOG(LEV_INFO2) << "Beginning DRE for time: " << time_;
     DoResEx(&matl_manager, &genrsrc_manager);
     CLOG(LEV_INFO2) << "Beginning Tock for time: " << time_;
+    UpdateListeners();
     DoTock();
     CLOG(LEV_INFO2) << "Beginning Decision for time: " << time_;
+    UpdateListeners();
     DoDecision();
     DoDecom();
+    if (ctx_->profiler()->enabled()) {
+      ctx_->profiler()->Flush(ctx_);
+    }
 
 #ifdef CYCLUS_WITH_PYTHON
-    EventLoop();
+    // every PY_EVENT_LOOP_INTERVAL time steps, or with 0 only while
+    // something is attached to the loop
+    int every = PY_EVENT_LOOP_INTERVAL;
+    if (every > 0 ? steps % every == 0 : PY_EVENT_LOOP_ATTACHED) {
+      EventLoop();
+    }
 #endif
+    steps++;
 
-    time_++;
+    time_ = NextTime();
 
     if (want_kill_) {
       break;
     }
   }
 
+  if (ctx_->profiler()->enabled()) {
+    ctx_->profiler()->Record(ctx_);
+  }
+
   ctx_->NewDatum("Finish")
       ->AddVal("EarlyTerm", want_kill_)
       ->AddVal("EndTime", time_ - 1)
@@ -64,85 +85,273 @@ void Timer::RunSim() {
 }
 
 void Timer::DoBuild() {
-  // build queued agents
-  std::vector<std::pair<std::string, Agent*>> build_list = build_queue_[time_];
-  for (int i = 0; i < build_list.size(); ++i) {
-    Agent* m = ctx_->CreateAgent<Agent>(build_list[i].first);
-    Agent* parent = build_list[i].second;
-    CLOG(LEV_INFO3) << "Building a " << build_list[i].first << " from parent "
-                    << build_list[i].second;
-    m->Build(parent);
-    if (parent != NULL) {
-      parent->BuildNotify(m);
+  ProfileScope prof(ctx_, "Build");
+  std::map<int, std::vector<BuildOrder>>::iterator it =
+      build_queue_.find(time_);
+  if (it == build_queue_.end()) {
+    return;
+  }
+  std::vector<BuildOrder> orders;
+  orders.swap(it->second);
+  build_queue_.erase(it);
+
+  // build queued agents, all agents of an order are cloned at once
+  int total = 0;
+  for (int i = 0; i < orders.size(); ++i) {
+    total += orders[i].n;
+  }
+  cpp_tickers_.reserve(cpp_tickers_.size() + total);
+  std::vector<Agent*> agents;
+  for (int i = 0; i < orders.size(); ++i) {
+    const BuildOrder& o = orders[i];
+    agents.clear();
+    ctx_->CreateAgents(o.proto, o.n, &agents);
+    CLOG(LEV_INFO3) << "Building " << o.n << " " << o.proto
+                    << " from parent " << o.parent;
+    for (int j = 0; j < agents.size(); ++j) {
+      Agent* m = agents[j];
+      m->Build(o.parent);
+      if (o.parent != NULL) {
+        o.parent->BuildNotify(m);
+      } else {
+        CLOG(LEV_DEBUG1) << "Hey! Listen! Built an Agent without a Parent.";
+      }
+    }
+  }
+}
+
+void Timer::UpdateListeners() {
+  // a listener that is both put to sleep and woken in the same phase stays
+  // awake and of several wake times the earliest counts, so the outcome does
+  // not depend on the order of the requests
+  std::map<int, SleepChange> changes;
+  for (int i = 0; i < sleep_changes_.size(); ++i) {
+    const SleepChange& c = sleep_changes_[i];
+    std::map<int, SleepChange>::iterator it = changes.find(c.id);
+    if (it == changes.end()) {
+      changes[c.id] = c;
+    } else if (it->second.until != -1 &&
+               (c.until == -1 || c.until < it->second.until)) {
+      it->second = c;
+    }
+  }
+  sleep_changes_.clear();
+
+  std::map<int, SleepChange>::iterator it;
+  for (it = changes.begin(); it != changes.end(); ++it) {
+    const SleepChange& c = it->second;
+    if (tickers_.count(c.id) == 0) {
+      continue;  // unregistered in the meantime
+    } else if (c.until == -1) {
+      listeners_dirty_ |= sleepers_.erase(c.id) > 0;
     } else {
-      CLOG(LEV_DEBUG1) << "Hey! Listen! Built an Agent without a Parent.";
+      Sleeper s = {c.until, c.wake_on_trade, c.dre_idle};
+      sleepers_[c.id] = s;
+      wake_queue_[c.until].push_back(c.id);
+      listeners_dirty_ = true;
+    }
+  }
+
+  while (!wake_queue_.empty() && wake_queue_.begin()->first <= time_) {
+    std::vector<int>& ids = wake_queue_.begin()->second;
+    for (int i = 0; i < ids.size(); ++i) {
+      std::map<int, Sleeper>::iterator s = sleepers_.find(ids[i]);
+      if (s != sleepers_.end() &&
+          s->second.until == wake_queue_.begin()->first) {
+        sleepers_.erase(s);
+        listeners_dirty_ = true;
+      }
+    }
+    wake_queue_.erase(wake_queue_.begin());
+  }
+
+  if (!listeners_dirty_) {
+    return;
+  }
+  listeners_dirty_ = false;
+
+  struct PhaseList {
+    const std::vector<TimeListener*>* all;
+    std::vector<TimeListener*>* awake;
+    int phase;
+  };
+  PhaseList lists[] = {
+      {&cpp_tickers_, &tick_cpp_, kTickPhase},
+      {&py_tickers_, &tick_py_, kTickPhase},
+      {&cpp_tickers_, &tock_cpp_, kTockPhase},
+      {&py_tickers_, &tock_py_, kTockPhase},
+  };
+  for (int l = 0; l < 4; ++l) {
+    lists[l].awake->clear();
+    for (TimeListener* tl : *lists[l].all) {
+      int id = tl->id();
+      if ((phases_[id] & lists[l].phase) && sleepers_.count(id) == 0) {
+        lists[l].awake->push_back(tl);
+      }
+    }
+  }
+
+  decision_.clear();
+  std::map<int, TimeListener*>::iterator t;
+  for (t = tickers_.begin(); t != tickers_.end(); ++t) {
+    int id = t->first;
+    if ((phases_[id] & kDecisionPhase) && sleepers_.count(id) == 0) {
+      decision_.push_back(t->second);
     }
   }
 }
 
 void Timer::DoTick() {
-  for (TimeListener* agent : py_tickers_) {
-    agent->Tick();
-  }
+  ProfileScope prof(ctx_, "Tick");
+  RunPhase(&tick_sched_, tick_cpp_, tick_py_, &TimeListener::Tick, "Tick",
+           "tick");
+}
 
-#pragma omp parallel for
-  for (size_t i = 0; i < cpp_tickers_.size(); ++i) {
-    cpp_tickers_[i]->Tick();
+void Timer::RunPhase(TaskScheduler* sched,
+                     const std::vector<TimeListener*>& cpp,
+                     const std::vector<TimeListener*>& py,
+                     void (TimeListener::*phase)(), const char* name,
+                     const char* py_name) {
+  int ncpp = cpp.size();
+  // batches are not profiled per agent, so profiling falls back to one call
+  // per agent
+  bool batch = PY_BATCH_DISPATCH && !ctx_->profiler()->enabled();
+  sched_keys_.resize(ncpp);
+  for (int i = 0; i < ncpp; ++i) {
+    sched_keys_[i] = cpp[i]->id();
   }
+
+#if CYCLUS_IS_PARALLEL
+  // resource/composition ids are handed out and output is recorded per
+  // listener so that neither depends on thread scheduling or the number of
+  // threads. Python listeners hold the interpreter lock and run on the
+  // calling thread before the C++ listeners, as in serial builds. A batch of
+  // Python listeners takes one more slot.
+  ParallelIdPhase ids(ncpp + py.size() + (batch ? 1 : 0));
+#endif  // CYCLUS_IS_PARALLEL
+  sched->Run(
+      sched_keys_,
+      [this, &cpp, phase, name](int i) {
+        ParallelIdPhase::EnterSlot(i);
+        ProfileScope prof(ctx_, name, cpp[i]->id());
+        (cpp[i]->*phase)();
+        ParallelIdPhase::LeaveSlot();
+      },
+      [this, &py, phase, name, py_name, ncpp, batch]() {
+        if (!batch) {
+          for (int j = 0; j < py.size(); ++j) {
+            ParallelIdPhase::EnterSlot(ncpp + j);
+            ProfileScope prof(ctx_, name, py[j]->id());
+            (py[j]->*phase)();
+            ParallelIdPhase::LeaveSlot();
+          }
+          return;
+        }
+
+        // all Python agents in one call (and id slot), then the listeners
+        // that turned out not to be Python agents in their own slots
+        std::vector<int> py_ids(py.size());
+        for (int j = 0; j < py.size(); ++j) {
+          py_ids[j] = py[j]->id();
+        }
+        ParallelIdPhase::EnterSlot(ncpp);
+        std::vector<int> rest = PyCallAgents(py_name, py_ids);
+        ParallelIdPhase::LeaveSlot();
+        for (int j = 0; j < rest.size(); ++j) {
+          std::map<int, TimeListener*>::iterator it = tickers_.find(rest[j]);
+          if (it == tickers_.end()) {
+            continue;  // unregistered by a Python agent in the meantime
+          }
+          ParallelIdPhase::EnterSlot(ncpp + 1 + j);
+          (it->second->*phase)();
+          ParallelIdPhase::LeaveSlot();
+        }
+      });
 }
 
 void Timer::DoResEx(ExchangeManager<Material>* matmgr,
                     ExchangeManager<Product>* genmgr) {
+  ProfileScope prof(ctx_, "ResourceExchange");
+  traded_ = false;
   matmgr->Execute();
   genmgr->Execute();
 }
 
 void Timer::DoTock() {
-  for (TimeListener* agent : py_tickers_) {
-    agent->Tock();
-  }
-
-#pragma omp parallel for
-  for (size_t i = 0; i < cpp_tickers_.size(); ++i) {
-    cpp_tickers_[i]->Tock();
-  }
+  ProfileScope prof(ctx_, "Tock");
+  RunPhase(&tock_sched_, tock_cpp_, tock_py_, &TimeListener::Tock, "Tock",
+           "tock");
 
   if (si_.explicit_inventory || si_.explicit_inventory_compact) {
-    std::set<Agent*> ags = ctx_->agent_list_;
+    const std::set<Agent*>& ags = ctx_->agent_list_;
     std::vector<Agent*> agent_vec(ags.begin(), ags.end());
+    // agent_list_ is ordered by address; order by id for reproducible ids.
+    std::sort(agent_vec.begin(), agent_vec.end(),
+              [](Agent* a, Agent* b) { return a->id() < b->id(); });
+
+    // carry over the caches of agents that are still around, each agent's
+    // cache is then only touched by its own iteration below
+    std::map<int, InventoryCache> caches;
+    std::vector<InventoryCache*> agent_caches(agent_vec.size());
+    for (int i = 0; i < agent_vec.size(); i++) {
+      int id = agent_vec[i]->id();
+      InventoryCache& c = caches[id];
+      std::map<int, InventoryCache>::iterator old = inv_caches_.find(id);
+      if (old != inv_caches_.end()) {
+        std::swap(c, old->second);
+      }
+      agent_caches[i] = &c;
+    }
+    inv_caches_.swap(caches);
+
+#if CYCLUS_IS_PARALLEL
+    ParallelIdPhase ids(agent_vec.size());
+#endif  // CYCLUS_IS_PARALLEL
 #pragma omp parallel for
     for (int i = 0; i < agent_vec.size(); i++) {
+      ParallelIdPhase::EnterSlot(i);
       Agent* a = agent_vec[i];
       if (a->enter_time() != -1) {
-        RecordInventories(a);
+        RecordInventories(a, agent_caches[i]);
       }
+      ParallelIdPhase::LeaveSlot();
     }
   }
 }
 
 void Timer::DoDecision() {
-  for (std::map<int, TimeListener*>::iterator agent = tickers_.begin();
-       agent != tickers_.end();
-       agent++) {
-    agent->second->Decision();
+  ProfileScope prof(ctx_, "Decision");
+  for (TimeListener* agent : decision_) {
+    ProfileScope agent_prof(ctx_, "Decision", agent->id());
+    agent->Decision();
   }
 }
 
-void Timer::RecordInventories(Agent* a) {
-  Inventories invs = a->SnapshotInv();
-  Inventories::iterator it2;
-  for (it2 = invs.begin(); it2 != invs.end(); ++it2) {
-    std::string name = it2->first;
-    std::vector<Resource::Ptr> mats = it2->second;
-    if (mats.empty() || ResCast<Material>(mats[0]) == NULL) {
-      continue;  // skip non-material inventories
-    }
+void Timer::RecordInventories(Agent* a, InventoryCache* cache) {
+  // unchanged inventories are recorded from their aggregates of the previous
+  // time step, which (lazily) decay just like the inventories themselves
+  int version = a->InventoryVersion();
+  if (version < 0 || version != cache->version) {
+    cache->version = version;
+    cache->invs.clear();
+    Inventories invs = a->SnapshotInv();
+    Inventories::iterator it2;
+    for (it2 = invs.begin(); it2 != invs.end(); ++it2) {
+      const std::vector<Resource::Ptr>& mats = it2->second;
+      if (mats.empty() || ResCast<Material>(mats[0]) == NULL) {
+        continue;  // skip non-material inventories
+      }
 
-    Material::Ptr m = ResCast<Material>(mats[0]->Clone());
-    for (int i = 1; i < mats.size(); i++) {
-      m->Absorb(ResCast<Material>(mats[i]->Clone()));
+      Material::Ptr m = ResCast<Material>(mats[0]->Clone());
+      for (int i = 1; i < mats.size(); i++) {
+        m->Absorb(ResCast<Material>(mats[i]->Clone()));
+      }
+      cache->invs.push_back(std::make_pair(it2->first, m));
     }
-    RecordInventory(a, name, m);
+  }
+
+  for (int i = 0; i < cache->invs.size(); ++i) {
+    RecordInventory(a, cache->invs[i].first, cache->invs[i].second);
   }
 }
 
@@ -178,10 +387,26 @@ void Timer::RecordInventory(Agent* a, std::string name, Material::Ptr m) {
 }
 
 void Timer::DoDecom() {
+  ProfileScope prof(ctx_, "Decom");
+  std::map<int, std::vector<Agent*>>::iterator it = decom_queue_.find(time_);
+  if (it == decom_queue_.end()) {
+    return;
+  }
+
   // decommission queued agents
-  std::vector<Agent*> decom_list = decom_queue_[time_];
+  std::vector<Agent*> decom_list;
+  decom_list.swap(it->second);
+  decom_queue_.erase(it);
+  for (int i = 0; i < decom_list.size(); ++i) {
+    if (decom_list[i] != NULL) {
+      decom_index_.erase(decom_list[i]->id());
+    }
+  }
   for (int i = 0; i < decom_list.size(); ++i) {
     Agent* m = decom_list[i];
+    if (m == NULL) {
+      continue;  // rescheduled
+    }
     if (m->parent() != NULL) {
       m->parent()->DecomNotify(m);
     }
@@ -189,8 +414,71 @@ void Timer::DoDecom() {
   }
 }
 
+int Timer::NextTime() {
+  int next = time_ + 1;
+  if (!si_.fast_forward || traded_ || want_snapshot_ || want_kill_ ||
+      si_.explicit_inventory || si_.explicit_inventory_compact) {
+    return next;
+  }
+
+  // sleep requests of the Decision phase take effect now
+  UpdateListeners();
+  if (!tick_cpp_.empty() || !tick_py_.empty() || !tock_cpp_.empty() ||
+      !tock_py_.empty() || !decision_.empty()) {
+    return next;
+  }
+
+  // sleeping agents still trade unless they declared that they don't, and
+  // what they trade may depend on the time
+  const std::set<Trader*>& traders = ctx_->traders();
+  std::set<Trader*>::const_iterator tr;
+  for (tr = traders.begin(); tr != traders.end(); ++tr) {
+    TimeListener* tl = dynamic_cast<TimeListener*>((*tr)->manager());
+    if (tl == NULL) {
+      return next;
+    }
+    std::map<int, Sleeper>::iterator s = sleepers_.find(tl->id());
+    if (s == sleepers_.end() || !s->second.dre_idle) {
+      return next;
+    }
+  }
+
+  // the queues may contain empty entries for past time steps, and entries of
+  // listeners that were woken early, which only shorten the jump
+  int t = si_.duration;
+  if (!wake_queue_.empty()) {
+    t = std::min(t, wake_queue_.begin()->first);
+  }
+  std::map<int, std::vector<BuildOrder>>::iterator b;
+  for (b = build_queue_.upper_bound(time_); b != build_queue_.end(); ++b) {
+    if (!b->second.empty()) {
+      t = std::min(t, b->first);
+      break;
+    }
+  }
+  std::map<int, std::vector<Agent*>>::iterator d;
+  for (d = decom_queue_.upper_bound(time_); d != decom_queue_.end(); ++d) {
+    std::vector<Agent*>& ags = d->second;
+    if (std::count(ags.begin(), ags.end(), (Agent*)NULL) < ags.size()) {
+      t = std::min(t, d->first);
+      break;
+    }
+  }
+
+  if (t > next) {
+    CLOG(LEV_INFO1) << "Fast forwarding from time " << next << " to " << t;
+    ctx_->NewDatum("FastForward")
+        ->AddVal("StartTime", next)
+        ->AddVal("EndTime", t - 1)
+        ->Record();
+  }
+  return std::max(t, next);
+}
+
 void Timer::RegisterTimeListener(TimeListener* agent) {
   tickers_[agent->id()] = agent;
+  phases_[agent->id()] = agent->TimePhases();
+  listeners_dirty_ = true;
   if (agent->IsShim()) {
     py_tickers_.push_back(agent);
   } else {
@@ -200,6 +488,9 @@ void Timer::RegisterTimeListener(TimeListener* agent) {
 
 void Timer::UnregisterTimeListener(TimeListener* tl) {
   tickers_.erase(tl->id());
+  phases_.erase(tl->id());
+  sleepers_.erase(tl->id());
+  listeners_dirty_ = true;
   if (tl->IsShim()) {
     py_tickers_.erase(std::remove(py_tickers_.begin(), py_tickers_.end(), tl),
                       py_tickers_.end());
@@ -210,11 +501,47 @@ void Timer::UnregisterTimeListener(TimeListener* tl) {
   }
 }
 
-void Timer::SchedBuild(Agent* parent, std::string proto_name, int t) {
+void Timer::Sleep(TimeListener* tl, int t, bool wake_on_trade,
+                  bool dre_idle) {
+  if (t <= time_) {
+    throw ValueError("Cannot sleep until t <= [current-time]");
+  }
+  SleepChange c = {tl->id(), t, wake_on_trade, dre_idle};
+#pragma omp critical(cyclus_timer_sleep)
+  sleep_changes_.push_back(c);
+}
+
+void Timer::Wake(TimeListener* tl) {
+  SleepChange c = {tl->id(), -1, false, false};
+#pragma omp critical(cyclus_timer_sleep)
+  sleep_changes_.push_back(c);
+}
+
+void Timer::NotifyTrade(Agent* a) {
+  traded_ = true;
+  TimeListener* tl = dynamic_cast<TimeListener*>(a);
+  if (tl == NULL) {
+    return;
+  }
+  std::map<int, Sleeper>::iterator it = sleepers_.find(tl->id());
+  if (it != sleepers_.end() && it->second.wake_on_trade) {
+    Wake(tl);
+  }
+}
+
+bool Timer::asleep(TimeListener* tl) {
+  return sleepers_.count(tl->id()) > 0;
+}
+
+void Timer::SchedBuild(Agent* parent, std::string proto_name, int t,
+                       int n) {
   if (t <= time_) {
     throw ValueError("Cannot schedule build for t < [current-time]");
   }
-  build_queue_[t].push_back(std::make_pair(proto_name, parent));
+  if (n > 0) {
+    BuildOrder o = {proto_name, parent, n};
+    build_queue_[t].push_back(o);
+  }
 }
 
 void Timer::SchedDecom(Agent* m, int t) {
@@ -227,26 +554,16 @@ void Timer::SchedDecom(Agent* m, int t) {
   // - the duplicate entries will result in a double delete attempt and
   // segfaults and otherwise bad things.  Remove previous decommissionings
   // before scheduling this new one.
-  std::map<int, std::vector<Agent*>>::iterator it;
-  bool done = false;
-  for (it = decom_queue_.begin(); it != decom_queue_.end(); ++it) {
-    int t = it->first;
-    std::vector<Agent*> ags = it->second;
-    for (int i = 0; i < ags.size(); i++) {
-      if (ags[i] == m) {
-        CLOG(LEV_WARN) << "scheduled over previous decommissioning of "
-                       << m->id();
-        decom_queue_[t].erase(decom_queue_[t].begin() + i);
-        done = true;
-        break;
-      }
-    }
-    if (done) {
-      break;
-    }
+  std::map<int, std::pair<int, int>>::iterator it = decom_index_.find(m->id());
+  if (it != decom_index_.end()) {
+    CLOG(LEV_WARN) << "scheduled over previous decommissioning of "
+                   << m->id();
+    decom_queue_[it->second.first][it->second.second] = NULL;
   }
 
-  decom_queue_[t].push_back(m);
+  std::vector<Agent*>& ags = decom_queue_[t];
+  decom_index_[m->id()] = std::make_pair(t, static_cast<int>(ags.size()));
+  ags.push_back(m);
 }
 
 int Timer::time() {
@@ -257,8 +574,22 @@ void Timer::Reset() {
   tickers_.clear();
   cpp_tickers_.clear();
   py_tickers_.clear();
+  phases_.clear();
+  tick_cpp_.clear();
+  tick_py_.clear();
+  tock_cpp_.clear();
+  tock_py_.clear();
+  decision_.clear();
+  listeners_dirty_ = false;
+  tick_sched_.Reset();
+  tock_sched_.Reset();
+  sleepers_.clear();
+  wake_queue_.clear();
+  sleep_changes_.clear();
   build_queue_.clear();
   decom_queue_.clear();
+  decom_index_.clear();
+  inv_caches_.clear();
   si_ = SimInfo(0);
 }
 
@@ -281,6 +612,12 @@ int Timer::dur() {
   return si_.duration;
 }
 
-Timer::Timer() : time_(0), si_(0), want_snapshot_(false), want_kill_(false) {}
+Timer::Timer()
+    : time_(0),
+      si_(0),
+      want_snapshot_(false),
+      want_kill_(false),
+      traded_(false),
+      listeners_dirty_(false) {}
 
 }  // namespace cyclus
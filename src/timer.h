@@ -9,6 +9,7 @@
 #include "product.h"
 #include "material.h"
 #include "infile_tree.h"
+#include "task_scheduler.h"
 #include "time_listener.h"
 #include "comp_math.h"
 
@@ -33,7 +34,9 @@ class Timer {
   /// resets all data (registered listeners, etc.) to empty or initial state
   void Reset();
 
-  /// Runs the simulation.
+  /// Runs the simulation. If SimInfo::fast_forward is set, time steps in
+  /// which nothing can happen are skipped (see NextTime). Materials decay
+  /// over the whole skipped period the next time they are decayed.
   void RunSim();
 
   /// Registers an agent to receive tick/tock notifications every timestep.
@@ -44,12 +47,25 @@ class Timer {
   /// Agents should unregister from their Decommission method.
   void UnregisterTimeListener(TimeListener* tl);
 
-  /// Schedules the named prototype to be built for the specified parent at
-  /// timestep t.
-  void SchedBuild(Agent* parent, std::string proto_name, int t);
+  /// Stops notifying a listener of the phases after the current one until
+  /// the Tick of timestep t, see Context::Sleep.
+  void Sleep(TimeListener* tl, int t, bool wake_on_trade, bool dre_idle);
+
+  /// Resumes notifying a sleeping listener from the next phase on.
+  void Wake(TimeListener* tl);
+
+  /// Wakes a sleeping agent that asked to be woken by trades.
+  void NotifyTrade(Agent* a);
+
+  /// Returns true if the listener is currently asleep.
+  bool asleep(TimeListener* tl);
+
+  /// Schedules n agents of the named prototype to be built for the specified
+  /// parent at timestep t.
+  void SchedBuild(Agent* parent, std::string proto_name, int t, int n = 1);
 
   /// Schedules the given Agent to be decommissioned at the specified
-  /// timestep t.
+  /// timestep t, replacing any decommissioning scheduled before.
   void SchedDecom(Agent* m, int time);
 
   /// Schedules a snapshot of simulation state to output database to occur at
@@ -70,9 +86,37 @@ class Timer {
   int dur();
 
  private:
+  /// a requested change of a listener's sleep state
+  struct SleepChange {
+    int id;
+    /// the time step to wake at, or -1 to wake right away
+    int until;
+    bool wake_on_trade;
+    bool dre_idle;
+  };
+
+  /// a batch of agents of one prototype to build
+  struct BuildOrder {
+    std::string proto;
+    Agent* parent;
+    int n;
+  };
+
+  /// a sleeping listener's wake time
+  struct Sleeper {
+    int until;
+    bool wake_on_trade;
+    bool dre_idle;
+  };
+
   /// builds all agents queued for the current timestep.
   void DoBuild();
 
+  /// applies the sleep changes requested during the previous phase, wakes
+  /// listeners that are due and rebuilds the per-phase listener lists if
+  /// anything changed
+  void UpdateListeners();
+
   /// sends the tick signal to all of the agents receiving time
   /// notifications.
   void DoTick();
@@ -85,16 +129,41 @@ class Timer {
   /// notifications.
   void DoTock();
 
+  /// runs a Tick or Tock phase with the given scheduler: C++ listeners are
+  /// scheduled by their cost history while the Python listeners run in order
+  /// on the calling thread (see PY_BATCH_DISPATCH); name is the phase name
+  /// for the profiler and py_name the method name of Python agents
+  void RunPhase(TaskScheduler* sched, const std::vector<TimeListener*>& cpp,
+                const std::vector<TimeListener*>& py,
+                void (TimeListener::*phase)(), const char* name,
+                const char* py_name);
+
   /// sends the decision signal to all agents recieving time
   /// notifications.
   void DoDecision();
 
-  void RecordInventories(Agent* a);
+  /// the aggregated material inventories of an agent (see
+  /// Agent::InventoryVersion)
+  struct InventoryCache {
+    InventoryCache() : version(-1) {}
+    int version;
+    std::vector<std::pair<std::string, Material::Ptr>> invs;
+  };
+
+  void RecordInventories(Agent* a, InventoryCache* cache);
   void RecordInventory(Agent* a, std::string name, Material::Ptr m);
 
   /// decommissions all agents queued for the current timestep.
   void DoDecom();
 
+  /// @return the next time step to simulate: the next one unless fast
+  /// forwarding is enabled and the simulation is quiet (no awake listeners,
+  /// every trader asleep and idle on the exchange, no trades in the current
+  /// time step and no snapshot pending), in which case it is the earliest
+  /// time step at which a listener wakes or an agent is built or
+  /// decommissioned
+  int NextTime();
+
   Context* ctx_;
 
   /// The current time, measured in months from when the simulation
@@ -106,18 +175,49 @@ class Timer {
   bool want_snapshot_;
   bool want_kill_;
 
+  /// whether any trade occurred in the current time step
+  bool traded_;
+
   /// Concrete agents that desire to receive tick and tock notifications
   std::map<int, TimeListener*> tickers_;
   /// The union of these two vectors should produce tickers_.
   /// Keeping C++ and Python agents separate helps support parallelization.
   std::vector<TimeListener*> cpp_tickers_;
   std::vector<TimeListener*> py_tickers_;
-
-  // std::map<time,std::vector<std::pair<prototype, parent> > >
-  std::map<int, std::vector<std::pair<std::string, Agent*>>> build_queue_;
-
-  // std::map<time,std::vector<config> >
+  /// The phases (see TimeListener::TimePhases) of each listener by id
+  std::map<int, int> phases_;
+
+  /// The awake listeners notified of each phase, in the order of the above
+  /// lists (Decision is sent in id order)
+  std::vector<TimeListener*> tick_cpp_;
+  std::vector<TimeListener*> tick_py_;
+  std::vector<TimeListener*> tock_cpp_;
+  std::vector<TimeListener*> tock_py_;
+  std::vector<TimeListener*> decision_;
+  bool listeners_dirty_;
+
+  /// Per-listener cost history of the Tick and Tock phases
+  TaskScheduler tick_sched_;
+  TaskScheduler tock_sched_;
+  std::vector<int> sched_keys_;
+
+  /// Explicit inventory aggregates by agent id
+  std::map<int, InventoryCache> inv_caches_;
+
+  /// Sleeping listeners by id and the calendar queue of their wake times
+  std::map<int, Sleeper> sleepers_;
+  std::map<int, std::vector<int>> wake_queue_;
+  std::vector<SleepChange> sleep_changes_;
+
+  /// the agents to build by time step
+  std::map<int, std::vector<BuildOrder>> build_queue_;
+
+  /// the agents to decommission by time step, rescheduled agents leave NULL
+  /// entries behind
   std::map<int, std::vector<Agent*>> decom_queue_;
+  /// the time step and position in decom_queue_ of each scheduled agent by
+  /// id
+  std::map<int, std::pair<int, int>> decom_index_;
 };
 
 }  // namespace cyclus
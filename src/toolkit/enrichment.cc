@@ -37,37 +37,15 @@ double UraniumAssay(Material::Ptr rsrc) {
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 double UraniumAssayAtom(Material::Ptr rsrc) {
-  double value;
-  MatQuery mq(rsrc);
-  double u235 = mq.atom_frac(922350000);
-  double u238 = mq.atom_frac(922380000);
-
-  LOG(LEV_DEBUG1, "CEnr") << "Comparing u235 atom fraction : " << u235
-                          << " with u238 atom fraction: " << u238;
-
-  if (u235 + u238 > 0) {
-    value = u235 / (u235 + u238);
-  } else {
-    value = 0;
-  }
+  double value = rsrc->comp()->u235_assay_atom();
+  LOG(LEV_DEBUG1, "CEnr") << "U-235 atom assay: " << value;
   return value;
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 double UraniumAssayMass(Material::Ptr rsrc) {
-  double value;
-  MatQuery mq(rsrc);
-  double u235 = mq.mass_frac(922350000);
-  double u238 = mq.mass_frac(922380000);
-
-  LOG(LEV_DEBUG1, "CEnr") << "Comparing u235 mass fraction : " << u235
-                          << " with u238 mass fraction: " << u238;
-
-  if (u235 + u238 > 0) {
-    value = u235 / (u235 + u238);
-  } else {
-    value = 0;
-  }
+  double value = rsrc->comp()->u235_assay_mass();
+  LOG(LEV_DEBUG1, "CEnr") << "U-235 mass assay: " << value;
   return value;
 }
 
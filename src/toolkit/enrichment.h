@@ -3,6 +3,7 @@
 
 #include <set>
 
+#include "capacity_constraint.h"
 #include "material.h"
 
 namespace cyclus {
@@ -78,6 +79,71 @@ double SwuRequired(double product_qty, const Assays& assays);
 /// @return the value function for a given fraction in [0,1)
 double ValueFunc(double frac);
 
+/// @class SWUConverter
+///
+/// @brief converts a uranium offer to the swu required to enrich it from the
+/// given feed assay, leaving tails of the given tails assay. The result
+/// depends only on the offer's composition and is proportional to its
+/// quantity, so conversions are memoized during translation.
+class SWUConverter : public Converter<Material> {
+ public:
+  SWUConverter(double feed, double tails) : feed_(feed), tails_(tails) {}
+
+  /// @returns the swu required to enrich the offer
+  virtual double convert(
+      Material::Ptr m,
+      Arc const* a = NULL,
+      ExchangeTranslationContext<Material> const* ctx = NULL) const {
+    Assays assays(feed_, UraniumAssayMass(m), tails_);
+    return SwuRequired(UraniumQty(m), assays);
+  }
+
+  /// @returns true if the other converter is a SWUConverter with the same
+  /// assays
+  virtual bool operator==(Converter<Material>& other) const {
+    SWUConverter* cast = dynamic_cast<SWUConverter*>(&other);
+    return cast != NULL && feed_ == cast->feed_ && tails_ == cast->tails_;
+  }
+
+  /// @returns true
+  virtual bool memoizable() const { return true; }
+
+ private:
+  double feed_, tails_;
+};
+
+/// @class NatUConverter
+///
+/// @brief converts a uranium offer to the quantity of feed required to
+/// enrich it from the given feed assay, leaving tails of the given tails
+/// assay. Like the SWUConverter, conversions are memoized during translation.
+class NatUConverter : public Converter<Material> {
+ public:
+  NatUConverter(double feed, double tails) : feed_(feed), tails_(tails) {}
+
+  /// @returns the feed quantity required to enrich the offer
+  virtual double convert(
+      Material::Ptr m,
+      Arc const* a = NULL,
+      ExchangeTranslationContext<Material> const* ctx = NULL) const {
+    Assays assays(feed_, UraniumAssayMass(m), tails_);
+    return FeedQty(UraniumQty(m), assays);
+  }
+
+  /// @returns true if the other converter is a NatUConverter with the same
+  /// assays
+  virtual bool operator==(Converter<Material>& other) const {
+    NatUConverter* cast = dynamic_cast<NatUConverter*>(&other);
+    return cast != NULL && feed_ == cast->feed_ && tails_ == cast->tails_;
+  }
+
+  /// @returns true
+  virtual bool memoizable() const { return true; }
+
+ private:
+  double feed_, tails_;
+};
+
 }  // namespace toolkit
 }  // namespace cyclus
 
@@ -21,9 +21,9 @@ double MatQuery::moles(Nuc nuc) {
 }
 
 double MatQuery::mass_frac(Nuc nuc) {
-  CompMap v = m_->comp()->mass();
-  compmath::Normalize(&v);
-  return v[nuc];
+  const CompMap& v = m_->comp()->mass_norm();
+  CompMap::const_iterator it = v.find(nuc);
+  return it != v.end() ? it->second : 0;
 }
 
 double MatQuery::mass_frac(std::set<Nuc> nucs) {
@@ -36,20 +36,20 @@ double MatQuery::mass_frac(std::set<Nuc> nucs) {
 }
 
 double MatQuery::atom_frac(Nuc nuc) {
-  CompMap v = m_->comp()->atom();
-  compmath::Normalize(&v);
-  return v[nuc];
+  const CompMap& v = m_->comp()->atom_norm();
+  CompMap::const_iterator it = v.find(nuc);
+  return it != v.end() ? it->second : 0;
 }
 
 double MatQuery::atom_frac(std::set<Nuc> nucs) {
-  CompMap v = m_->comp()->atom();
-  compmath::Normalize(&v);
+  const CompMap& v = m_->comp()->atom_norm();
 
   double frac_tot = 0;
   std::set<Nuc>::iterator it;
   for (it = nucs.begin(); it != nucs.end(); ++it) {
-    if (v.find(*it) != v.end()) {
-      frac_tot += v[*it];
+    CompMap::const_iterator found = v.find(*it);
+    if (found != v.end()) {
+      frac_tot += found->second;
     }
   }
   return frac_tot;
@@ -72,19 +72,13 @@ double MatQuery::atom_frac(std::string nuc) {
 }
 
 bool MatQuery::AlmostEq(Material::Ptr other, double threshold) {
-  CompMap n1 = m_->comp()->mass();
-  CompMap n2 = other->comp()->mass();
-  compmath::Normalize(&n1);
-  compmath::Normalize(&n2);
-  return compmath::AlmostEq(n1, n2, threshold);
+  return compmath::AlmostEq(m_->comp()->mass_norm(),
+                            other->comp()->mass_norm(), threshold);
 }
 
 double MatQuery::Amount(Composition::Ptr c) {
-  CompMap m = m_->comp()->mass();
-  CompMap m_other = c->mass();
-
-  compmath::Normalize(&m);
-  compmath::Normalize(&m_other);
+  CompMap m = m_->comp()->mass_norm();
+  CompMap m_other = c->mass_norm();
 
   Nuc limiter;
   double min_ratio = cyclus::CY_LARGE_DOUBLE;
@@ -3,6 +3,7 @@
 #include <sstream>
 
 #include "error.h"
+#include "offer_cache.h"
 
 #define LG(X) LOG(LEV_##X, "buypol")
 #define LGH(X)                                                    \
@@ -299,7 +300,9 @@ std::set<RequestPortfolio<Material>::Ptr> MatlBuyPolicy::GetMatlRequests() {
   LGH(INFO3) << "requesting " << amt << " kg via " << n_req << " request(s)"
              << std::endl;
 
-  // one portfolio for each request
+  // one portfolio for each request, all requests for a commodity share their
+  // target
+  OfferCache targets;
   for (int i = 0; i != n_req; i++) {
     RequestPortfolio<Material>::Ptr port(new RequestPortfolio<Material>());
     std::vector<Request<Material>*> mreqs;
@@ -308,7 +311,7 @@ std::set<RequestPortfolio<Material>::Ptr> MatlBuyPolicy::GetMatlRequests() {
       std::string commod = it->first;
       CommodDetail d = it->second;
       LG(INFO3) << "  - one " << amt << " kg request of " << commod;
-      Material::Ptr m = Material::CreateUntracked(req_amt, d.comp);
+      Material::Ptr m = targets.Get(req_amt, d.comp);
       Request<Material>* r = port->AddRequest(m, this, commod, d.pref, excl);
       mreqs.push_back(r);
     }
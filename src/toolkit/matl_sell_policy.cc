@@ -2,6 +2,7 @@
 
 #include "error.h"
 #include "comp_math.h"
+#include "offer_cache.h"
 
 #define LG(X) LOG(LEV_##X, "selpol")
 #define LGH(X)                                                    \
@@ -197,6 +198,10 @@ std::set<BidPortfolio<Material>::Ptr> MatlSellPolicy::GetMatlBids(
   std::vector<double> bids;
   std::set<std::string>::iterator sit;
   std::vector<Request<Material>*>::const_iterator rit;
+  // equal non-exclusive bids (e.g., full packages) share their offer. The
+  // exchange groups exclusive bids by their offer, so each quantized bid
+  // needs its own.
+  OfferCache offers;
   for (sit = commods_.begin(); sit != commods_.end(); ++sit) {
     commod = *sit;
     if (commod_requests.count(commod) < 1) continue;
@@ -227,9 +232,8 @@ std::set<BidPortfolio<Material>::Ptr> MatlSellPolicy::GetMatlBids(
 
       std::vector<double>::iterator bit;
       for (bit = bids.begin(); bit != bids.end(); ++bit) {
-        offer = ignore_comp_
-                    ? Material::CreateUntracked(*bit, req->target()->comp())
-                    : Material::CreateUntracked(*bit, m->comp());
+        Composition::Ptr c = ignore_comp_ ? req->target()->comp() : m->comp();
+        offer = excl ? Material::CreateUntracked(*bit, c) : offers.Get(*bit, c);
         port->AddBid(req, offer, this, excl);
         LG(INFO3) << "  - bid " << *bit << " kg on a request for " << commod;
       }
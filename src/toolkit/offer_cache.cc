@@ -0,0 +1,19 @@
+#include "offer_cache.h"
+
+namespace cyclus {
+namespace toolkit {
+
+Material::Ptr OfferCache::Get(double qty, Composition::Ptr c) {
+  Material::Ptr& m = offers_[Key(qty, c.get())];
+  if (m == NULL) {
+    m = Material::CreateUntracked(qty, c);
+  }
+  return m;
+}
+
+void OfferCache::Clear() {
+  offers_.clear();
+}
+
+}  // namespace toolkit
+}  // namespace cyclus
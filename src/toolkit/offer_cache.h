@@ -0,0 +1,44 @@
+#ifndef CYCLUS_SRC_TOOLKIT_OFFER_CACHE_H_
+#define CYCLUS_SRC_TOOLKIT_OFFER_CACHE_H_
+
+#include <map>
+#include <utility>
+
+#include "composition.h"
+#include "material.h"
+
+namespace cyclus {
+namespace toolkit {
+
+/// OfferCache hands out the untracked materials that describe a quantity and
+/// composition in requests (as their target) and bids (as their
+/// offer). Identical descriptions share a single material, so that a trader
+/// making many equal requests or bids - e.g., one per package or per
+/// quantized order - allocates one material instead of one per request or bid.
+/// Materials for the trades that actually clear are created as usual when the
+/// trades are executed.
+///
+/// @warning materials handed out by the cache are shared and must not be
+/// modified. Exclusive bids must not share their offer, since the exchange
+/// groups them by it.
+class OfferCache {
+ public:
+  /// Returns an untracked material with the given description, creating it if
+  /// it does not exist in the cache.
+  Material::Ptr Get(double qty, Composition::Ptr c);
+
+  /// Removes all materials from the cache.
+  void Clear();
+
+  /// Returns the number of distinct materials in the cache.
+  inline int size() const { return offers_.size(); }
+
+ private:
+  typedef std::pair<double, const Composition*> Key;
+  std::map<Key, Material::Ptr> offers_;
+};
+
+}  // namespace toolkit
+}  // namespace cyclus
+
+#endif  // CYCLUS_SRC_TOOLKIT_OFFER_CACHE_H_
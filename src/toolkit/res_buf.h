@@ -61,7 +61,7 @@ typedef std::vector<Product::Ptr> ProdVec;
 template <class T> class ResBuf {
  public:
   ResBuf(bool is_bulk = false, bool keep_pkg = false)
-      : qty_(0), is_bulk_(is_bulk) {
+      : qty_(0), is_bulk_(is_bulk), version_(0) {
     capacity(INFINITY);
     keep_packaging(keep_pkg);
   }
@@ -120,6 +120,17 @@ template <class T> class ResBuf {
   /// Returns true if there are no resources in the buffer.
   inline bool empty() const { return rs_.empty(); }
 
+  /// Returns a counter that increases whenever the contents of the buffer
+  /// may have changed, including when a resource is handed out for in-place
+  /// modification by Peek (see Agent::InventoryVersion). Never throws.
+  inline int version() const { return version_; }
+
+  /// Returns all resources in the buffer, in the order they would be popped,
+  /// without removing them. Never throws.
+  ResVec ResValues() const {
+    return ResVec(rs_.begin(), rs_.end());
+  }
+
   /// Pops and returns the specified quantity from the buffer as a vector of
   /// resources.
   /// Resources are split if necessary in order to pop the exact quantity
@@ -136,6 +147,7 @@ template <class T> class ResBuf {
       throw ValueError(ss.str());
     }
 
+    ++version_;
     std::vector<typename T::Ptr> rs;
     typename T::Ptr r;
     typename T::Ptr tmp;
@@ -147,7 +159,7 @@ template <class T> class ResBuf {
       quan = r->quantity();
       if (quan > left) {
         // too big - split the res before popping
-        tmp = boost::dynamic_pointer_cast<T>(r->ExtractRes(left));
+        tmp = cyclus::ResCast<T>(r->ExtractRes(left));
         rs_.push_front(r);
         r = tmp;
       } else {
@@ -202,6 +214,7 @@ template <class T> class ResBuf {
       throw ValueError(ss.str());
     }
 
+    ++version_;
     std::vector<typename T::Ptr> rs;
     for (int i = 0; i < n; i++) {
       typename T::Ptr r = rs_.front();
@@ -224,6 +237,7 @@ template <class T> class ResBuf {
     if (rs_.size() < 1) {
       throw ValueError("cannot peek at resource from an empty buff");
     }
+    ++version_;
     return rs_.front();
   }
 
@@ -236,6 +250,7 @@ template <class T> class ResBuf {
     if (rs_.size() < 1) {
       throw ValueError("cannot pop resource from an empty buff");
     }
+    ++version_;
 
     typename T::Ptr r = rs_.front();
     rs_.pop_front();
@@ -250,6 +265,7 @@ template <class T> class ResBuf {
     if (rs_.size() < 1) {
       throw ValueError("cannot pop resource from an empty buff");
     }
+    ++version_;
 
     typename T::Ptr r = rs_.back();
     rs_.pop_back();
@@ -270,7 +286,7 @@ template <class T> class ResBuf {
   /// @throws KeyError the resource object to be pushed is already present
   /// in the buffer.
   void Push(Resource::Ptr r) {
-    typename T::Ptr m = boost::dynamic_pointer_cast<T>(r);
+    typename T::Ptr m = cyclus::ResCast<T>(r);
     if (m == NULL) {
       throw CastError("pushing wrong type of resource onto ResBuf");
     } else if (r->quantity() - space() > eps_rsrc()) {
@@ -281,6 +297,7 @@ template <class T> class ResBuf {
     } else if (rs_present_.count(m) == 1) {
       throw KeyError("duplicate resource push attempted");
     }
+    ++version_;
 
     if (!is_bulk_ || rs_.size() == 0) {
       // strip package id and set as default
@@ -312,7 +329,7 @@ template <class T> class ResBuf {
     std::vector<typename T::Ptr> rss;
     typename T::Ptr r;
     for (int i = 0; i < rs.size(); i++) {
-      r = boost::dynamic_pointer_cast<T>(rs[i]);
+      r = cyclus::ResCast<T>(rs[i]);
       if (r == NULL) {
         throw CastError("pushing wrong type of resource onto ResBuf");
       }
@@ -332,6 +349,7 @@ template <class T> class ResBuf {
         throw KeyError("Duplicate resource pushing attempted");
       }
     }
+    ++version_;
 
     for (int i = 0; i < rss.size(); i++) {
       if (!is_bulk_ || rs_.size() == 0) {
@@ -347,10 +365,14 @@ template <class T> class ResBuf {
     qty_ += tot_qty;
   }
 
-  /// Decays all the materials in a resource buffer
+  /// Decays all the materials in a resource buffer.  Materials whose
+  /// compositions are stable (or would not change significantly over the
+  /// elapsed time) are skipped using the decay metadata cached on their
+  /// compositions, so buffers of e.g. depleted uranium are cheap to decay.
   /// @param curr_time time to calculate decay inventory
   ///        (default: -1 uses the current time of the context)
   void Decay(int curr_time = -1) {
+    ++version_;
     for (auto rs : rs_) {
       rs->Decay(curr_time);
     }
@@ -381,6 +403,9 @@ template <class T> class ResBuf {
   /// List of constituent resource objects forming the buffer's inventory
   std::list<typename T::Ptr> rs_;
   std::set<typename T::Ptr> rs_present_;
+
+  /// See version()
+  int version_;
 };
 
 }  // namespace toolkit
@@ -40,7 +40,7 @@ namespace toolkit {
 /// @endcode
 template <class K, class R> class ResMap {
  public:
-  ResMap() : dirty_quantity_(true), quantity_(0) {
+  ResMap() : dirty_quantity_(true), quantity_(0), version_(0) {
     Warn<EXPERIMENTAL_WARNING>(
         "ResMap is experimental and its API may be "
         "subject to change");
@@ -81,11 +81,17 @@ template <class K, class R> class ResMap {
   void obj_ids(obj_type oi) {
     obj_ids_ = oi;
     dirty_quantity_ = true;
+    ++version_;
   }
 
   /// Returns true if there are no resources in the map.
   inline bool empty() const { return resources_.empty(); }
 
+  /// Returns a counter that increases whenever the contents of the map may
+  /// have changed, including when mutable access to them is handed out (see
+  /// Agent::InventoryVersion).
+  inline int version() const { return version_; }
+
   //
   // std::map interface
   //
@@ -93,18 +99,21 @@ template <class K, class R> class ResMap {
   /// Returns a reference to a resource pointer given a key.
   typename R::Ptr& operator[](const K& k) {
     dirty_quantity_ = true;
+    ++version_;
     return resources_[k];
   };
 
   /// Returns a reference to a resource pointer given a key.
   const typename R::Ptr& operator[](const K& k) const {
     dirty_quantity_ = true;
+    ++version_;
     return const_cast<map_type&>(resources_)[k];
   };
 
   /// Returns an iterator to the begining of the map.
   iterator begin() {
     dirty_quantity_ = true;
+    ++version_;
     return resources_.begin();
   }
 
@@ -117,6 +126,7 @@ template <class K, class R> class ResMap {
   /// Returns an iterator to the end of the map.
   iterator end() {
     dirty_quantity_ = true;
+    ++version_;
     return resources_.end();
   }
 
@@ -129,12 +139,14 @@ template <class K, class R> class ResMap {
   /// Removes an element at a given position in the map.
   void erase(iterator position) {
     resources_.erase(position);
+    ++version_;
     UpdateQuantity();
   };
 
   /// Removes an element from the map, given its key.
   typename map_type::size_type erase(const K& k) {
     typename map_type::size_type s = resources_.erase(k);
+    ++version_;
     UpdateQuantity();
     return s;
   };
@@ -142,6 +154,7 @@ template <class K, class R> class ResMap {
   /// Removes elements along a range from the first to last position in the map.
   void erase(iterator first, iterator last) {
     resources_.erase(first, last);
+    ++version_;
     UpdateQuantity();
   };
 
@@ -150,6 +163,7 @@ template <class K, class R> class ResMap {
     resources_.clear();
     obj_ids_.clear();
     dirty_quantity_ = true;
+    ++version_;
   };
 
   //
@@ -188,6 +202,7 @@ template <class K, class R> class ResMap {
       resources_[lookup[vals[i]->obj_id()]] = vals[i];
     }
     dirty_quantity_ = true;
+    ++version_;
   }
 
   /// Sets the resource values of map based on their object ids. Thus the
@@ -208,6 +223,7 @@ template <class K, class R> class ResMap {
     typename R::Ptr val = it->second;
     resources_.erase(it);
     dirty_quantity_ = true;
+    ++version_;
     return val;
   }
 
@@ -238,6 +254,9 @@ template <class K, class R> class ResMap {
   /// Current total quantity of all resources in the mapping.
   double quantity_;
 
+  /// See version()
+  mutable int version_;
+
   /// Underlying container
   map_type resources_;
 
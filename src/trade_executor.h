@@ -2,7 +2,6 @@
 #define CYCLUS_SRC_TRADE_EXECUTOR_H_
 
 #include <map>
-#include <set>
 #include <utility>
 #include <vector>
 
@@ -16,23 +15,27 @@ namespace cyclus {
 /// @class TradeExecutor::Context
 ///
 /// @brief a holding class for information related to a TradeExecutor
+///
+/// Suppliers and requesters are kept in the order of their first trade, and
+/// all per-trader containers are indexed like them.
 template <class T> struct TradeExecutionContext {
-  std::set<Trader*> suppliers;
-  std::set<Trader*> requesters;
-
-  // the key is the supplier
-  std::map<Trader*, std::vector<Trade<T>>> trades_by_supplier;
-
-  // the key is the requester, values are a vector of the target Trade with the
-  // associated response resource provided by the supplier
-  std::map<Trader*, std::vector<std::pair<Trade<T>, typename T::Ptr>>>
-      trades_by_requester;
-
-  // by convention, the first trader is the supplier, the second is the
-  // requester
-  std::map<std::pair<Trader*, Trader*>,
-           std::vector<std::pair<Trade<T>, typename T::Ptr>>>
-      all_trades;
+  typedef std::pair<Trade<T>, typename T::Ptr> Response;
+
+  std::vector<Trader*> suppliers;
+  std::vector<Trader*> requesters;
+
+  // the index of each requester in requesters
+  std::map<Trader*, int> requester_index;
+
+  // the trades of each supplier
+  std::vector<std::vector<Trade<T>>> trades_by_supplier;
+
+  // the target Trades with the associated response resource provided by each
+  // supplier
+  std::vector<std::vector<Response>> responses;
+
+  // the responses sent to each requester, in supplier order
+  std::vector<std::vector<Response>> trades_by_requester;
 };
 
 /// @class TradeExecutor
@@ -43,6 +46,13 @@ template <class T> struct TradeExecutionContext {
 ///     #. Collecting responses for the group of trades from each supplier
 ///     #. Grouping all responses by requester (receiver)
 ///     #. Sending all grouped responses to their respective requester
+///
+/// Responses are collected from and sent to traders that opt into concurrent
+/// execution (see TimeListener::IsShim) concurrently. Whatever the traders
+/// record meanwhile (e.g., the resources they split off) is buffered per
+/// trader by the Recorder and written in trader order. Transactions are
+/// recorded afterwards in supplier order, so that their ids do not depend on
+/// thread scheduling.
 template <class T> class TradeExecutor {
  public:
   explicit TradeExecutor(const std::vector<Trade<T>>& trades)
@@ -67,6 +77,20 @@ template <class T> class TradeExecutor {
       RecordTrades(ctx);
     }
     SendTradeResources(trade_ctx_);
+    if (ctx != NULL) {
+      WakeTraders(ctx);
+    }
+  }
+
+  /// @brief notifies the context of every supplier and requester that took
+  /// part in a trade, waking those that sleep until they trade
+  void WakeTraders(Context* ctx) {
+    for (int i = 0; i != trade_ctx_.suppliers.size(); ++i) {
+      ctx->NotifyTrade(trade_ctx_.suppliers[i]->manager());
+    }
+    for (int i = 0; i != trade_ctx_.requesters.size(); ++i) {
+      ctx->NotifyTrade(trade_ctx_.requesters[i]->manager());
+    }
   }
 
   /// @brief Record all trades with the appropriate backends
@@ -74,22 +98,14 @@ template <class T> class TradeExecutor {
   /// @param ctx the Context through which communication with backends will
   /// occur
   void RecordTrades(Context* ctx) {
-    // record all trades
-    typename std::map<
-        std::pair<Trader*, Trader*>,
-        std::vector<std::pair<Trade<T>, typename T::Ptr>>>::iterator m_it;
-    for (m_it = trade_ctx_.all_trades.begin();
-         m_it != trade_ctx_.all_trades.end();
-         ++m_it) {
-      Agent* supplier = m_it->first.first->manager();
-      Agent* requester = m_it->first.second->manager();
-      typename std::vector<std::pair<Trade<T>, typename T::Ptr>>& trades =
-          m_it->second;
-      typename std::vector<std::pair<Trade<T>, typename T::Ptr>>::iterator v_it;
-      for (v_it = trades.begin(); v_it != trades.end(); ++v_it) {
-        Trade<T>& trade = v_it->first;
-        typename T::Ptr rsrc = v_it->second;
+    for (int i = 0; i != trade_ctx_.suppliers.size(); ++i) {
+      Agent* supplier = trade_ctx_.suppliers[i]->manager();
+      const std::vector<Response>& responses = trade_ctx_.responses[i];
+      for (int j = 0; j != responses.size(); ++j) {
+        const Trade<T>& trade = responses[j].first;
+        typename T::Ptr rsrc = responses[j].second;
         if (rsrc->quantity() > cyclus::eps_rsrc()) {
+          Agent* requester = trade.request->requester()->manager();
           ctx->NewDatum("Transactions")
               ->AddVal("TransactionId", ctx->NextTransactionID())
               ->AddVal("SenderId", supplier->id())
@@ -110,60 +126,73 @@ template <class T> class TradeExecutor {
   inline TradeExecutionContext<T>& trade_ctx() { return trade_ctx_; }
 
  private:
+  typedef typename TradeExecutionContext<T>::Response Response;
+
   const std::vector<Trade<T>>& trades_;
   TradeExecutionContext<T> trade_ctx_;
 };
 
-/// @brief populates suppliers_, requesters_, and trades_by_supplier_
+/// @brief populates suppliers, requesters, and trades_by_supplier
 template <class T>
 void GroupTradesBySupplier(TradeExecutionContext<T>& trade_ctx,
                            const std::vector<Trade<T>>& trades) {
+  std::map<Trader*, int> supplier_index;
   typename std::vector<Trade<T>>::const_iterator it;
   for (it = trades.begin(); it != trades.end(); ++it) {
-    trade_ctx.trades_by_supplier[it->bid->bidder()].push_back(*it);
-    trade_ctx.suppliers.insert(it->bid->bidder());
-    trade_ctx.requesters.insert(it->request->requester());
+    Trader* supplier = it->bid->bidder();
+    std::map<Trader*, int>::iterator s_it = supplier_index.find(supplier);
+    if (s_it == supplier_index.end()) {
+      s_it = supplier_index.insert(
+          std::make_pair(supplier, trade_ctx.suppliers.size())).first;
+      trade_ctx.suppliers.push_back(supplier);
+      trade_ctx.trades_by_supplier.push_back(std::vector<Trade<T>>());
+    }
+    trade_ctx.trades_by_supplier[s_it->second].push_back(*it);
+
+    Trader* requester = it->request->requester();
+    if (trade_ctx.requester_index.count(requester) == 0) {
+      trade_ctx.requester_index[requester] = trade_ctx.requesters.size();
+      trade_ctx.requesters.push_back(requester);
+    }
   }
 }
 
 /// @brief queries each supplier for the responses to thier matched trade and
-/// populates trades_by_requester_ and all_trades_ with the results
+/// populates responses and trades_by_requester with the results
 template <class T>
 static void GetTradeResponses(TradeExecutionContext<T>& trade_ctx) {
-  std::set<Trader*>::iterator it;
-  for (it = trade_ctx.suppliers.begin(); it != trade_ctx.suppliers.end();
-       ++it) {
-    // get responses
-    Trader* supplier = *it;
-    std::vector<std::pair<Trade<T>, typename T::Ptr>> responses;
-    PopulateTradeResponses(supplier, trade_ctx.trades_by_supplier[supplier],
-                           responses);
-
-    // populate containers
-    typename std::vector<std::pair<Trade<T>, typename T::Ptr>>::iterator r_it;
-    for (r_it = responses.begin(); r_it != responses.end(); ++r_it) {
+  typedef typename TradeExecutionContext<T>::Response Response;
+  trade_ctx.responses.resize(trade_ctx.suppliers.size());
+  ForEachTrader(trade_ctx.suppliers, false, [&](int i) {
+    PopulateTradeResponses(trade_ctx.suppliers[i],
+                           trade_ctx.trades_by_supplier[i],
+                           trade_ctx.responses[i]);
+  });
+
+  // populate containers
+  trade_ctx.trades_by_requester.resize(trade_ctx.requesters.size());
+  for (int i = 0; i != trade_ctx.responses.size(); ++i) {
+    const std::vector<Response>& responses = trade_ctx.responses[i];
+    for (int j = 0; j != responses.size(); ++j) {
       // @todo unsure if this is needed...
       // Trade<T>& trade = r_it->first;
       // typename T::Ptr rsrc= r_it->second;
       // if (rsrc->quantity() != trade.amt) {
       //   throw ValueError("Trade amt and resource qty must match");
       // }
-      Trader* requester = r_it->first.request->requester();
-      trade_ctx.trades_by_requester[requester].push_back(*r_it);
-      trade_ctx.all_trades[std::make_pair(supplier, requester)].push_back(
-          *r_it);
+      Trader* requester = responses[j].first.request->requester();
+      int r = trade_ctx.requester_index[requester];
+      trade_ctx.trades_by_requester[r].push_back(responses[j]);
     }
   }
 }
 
 template <class T>
 static void SendTradeResources(TradeExecutionContext<T>& trade_ctx) {
-  std::set<Trader*>::iterator it;
-  for (it = trade_ctx.requesters.begin(); it != trade_ctx.requesters.end();
-       ++it) {
-    Trader* requester = *it;
-    AcceptTrades(requester, trade_ctx.trades_by_requester[requester]);
-  }
+  trade_ctx.trades_by_requester.resize(trade_ctx.requesters.size());
+  ForEachTrader(trade_ctx.requesters, false, [&](int i) {
+    AcceptTrades(trade_ctx.requesters[i], trade_ctx.trades_by_requester[i]);
+  });
 }
 
 }  // namespace cyclus
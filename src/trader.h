@@ -49,11 +49,17 @@ class Trader {
     return std::set<BidPortfolio<Product>::Ptr>();
   }
 
-  /// default implementation for material preferences.
-  virtual void AdjustMatlPrefs(PrefMap<Material>::type& prefs) {}
+  /// default implementation for material preferences. Agent types that keep
+  /// it are not asked to adjust preferences again, so overrides should not
+  /// call it.
+  virtual void AdjustMatlPrefs(PrefMap<Material>::type& prefs) {
+    DefaultPrefs::Reached();
+  }
 
-  /// default implementation for material preferences.
-  virtual void AdjustProductPrefs(PrefMap<Product>::type& prefs) {}
+  /// default implementation for product preferences, see AdjustMatlPrefs.
+  virtual void AdjustProductPrefs(PrefMap<Product>::type& prefs) {
+    DefaultPrefs::Reached();
+  }
 
   /// @brief default implementation for responding to material trades
   /// @param trades all trades in which this trader is the supplier
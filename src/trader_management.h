@@ -1,14 +1,94 @@
 #ifndef CYCLUS_SRC_TRADER_MANAGEMENT_H_
 #define CYCLUS_SRC_TRADER_MANAGEMENT_H_
 
+#include <exception>
+#include <functional>
+#include <map>
+#include <vector>
+
 #include "error.h"
 #include "exchange_context.h"
+#include "id_allocator.h"
+#include "platform.h"
 #include "product.h"
+#include "profiler.h"
 #include "material.h"
+#include "time_listener.h"
 #include "trader.h"
 
 namespace cyclus {
 
+/// @brief returns true if the agent opts into concurrent execution
+inline bool ConcurrentAgent(Agent* a) {
+  TimeListener* tl = dynamic_cast<TimeListener*>(a);
+  return tl != NULL && !tl->IsShim();
+}
+
+/// @brief calls f(i) for each trader i, concurrently for traders that support
+/// it (including their parents if with_parents is true) and in order from the
+/// calling thread for all others. Traders of the same manager (e.g., several
+/// policies of one facility) share its state and are called in order within
+/// one task. With parents, all traders below the same top-level agent (e.g.,
+/// the facilities of one region) share that task, because the parents they
+/// have in common are called for each of them.
+inline void ForEachTrader(const std::vector<Trader*>& traders,
+                          bool with_parents,
+                          const std::function<void(int)>& f) {
+#if CYCLUS_IS_PARALLEL
+  std::map<Agent*, int> group_index;
+  std::vector<std::vector<int>> groups;
+  for (int i = 0; i < traders.size(); ++i) {
+    Agent* group = traders[i]->manager();
+    bool c = ConcurrentAgent(group);
+    while (c && with_parents && group->parent() != NULL) {
+      group = group->parent();
+      c = ConcurrentAgent(group);
+    }
+    if (!c) {
+      f(i);
+      continue;
+    }
+
+    std::map<Agent*, int>::iterator it = group_index.find(group);
+    if (it == group_index.end()) {
+      it = group_index.insert(std::make_pair(group, groups.size())).first;
+      groups.push_back(std::vector<int>());
+    }
+    groups[it->second].push_back(i);
+  }
+
+  // ids are handed out and output is recorded per trader, and traders that
+  // share state run in order within one group, so that neither depends on
+  // thread scheduling or the number of threads.
+  std::vector<std::exception_ptr> errors(groups.size());
+  {
+    ParallelIdPhase ids(traders.size());
+#pragma omp parallel for schedule(dynamic)
+    for (int k = 0; k < groups.size(); ++k) {
+      try {
+        for (int j = 0; j < groups[k].size(); ++j) {
+          ParallelIdPhase::EnterSlot(groups[k][j]);
+          f(groups[k][j]);
+          ParallelIdPhase::LeaveSlot();
+        }
+      } catch (...) {
+        ParallelIdPhase::LeaveSlot();
+        errors[k] = std::current_exception();
+      }
+    }
+  }
+  for (int k = 0; k < errors.size(); ++k) {
+    if (errors[k]) {
+      std::rethrow_exception(errors[k]);
+    }
+  }
+#else
+  for (int i = 0; i < traders.size(); ++i) {
+    f(i);
+  }
+#endif  // CYCLUS_IS_PARALLEL
+}
+
 // template specializations to support inheritance and virtual functions
 template <class T>
 inline static std::set<typename RequestPortfolio<T>::Ptr> QueryRequests(
@@ -19,12 +99,14 @@ inline static std::set<typename RequestPortfolio<T>::Ptr> QueryRequests(
 template <>
 inline std::set<RequestPortfolio<Material>::Ptr> QueryRequests<Material>(
     Trader* t) {
+  ProfileScope prof(t->manager(), "GetMatlRequests");
   return t->GetMatlRequests();
 }
 
 template <>
 inline std::set<RequestPortfolio<Product>::Ptr> QueryRequests<Product>(
     Trader* t) {
+  ProfileScope prof(t->manager(), "GetProductRequests");
   return t->GetProductRequests();
 }
 
@@ -37,12 +119,14 @@ inline static std::set<typename BidPortfolio<T>::Ptr> QueryBids(
 template <>
 inline std::set<BidPortfolio<Material>::Ptr> QueryBids<Material>(
     Trader* t, CommodMap<Material>::type& map) {
+  ProfileScope prof(t->manager(), "GetMatlBids");
   return t->GetMatlBids(map);
 }
 
 template <>
 inline std::set<BidPortfolio<Product>::Ptr> QueryBids<Product>(
     Trader* t, CommodMap<Product>::type& map) {
+  ProfileScope prof(t->manager(), "GetProductBids");
   return t->GetProductBids(map);
 }
 
@@ -61,6 +145,7 @@ inline void PopulateTradeResponses<Material>(
     Trader* trader,
     const std::vector<Trade<Material>>& trades,
     std::vector<std::pair<Trade<Material>, Material::Ptr>>& responses) {
+  ProfileScope prof(trader->manager(), "GetMatlTrades");
   dynamic_cast<Trader*>(trader)->GetMatlTrades(trades, responses);
 }
 
@@ -69,6 +154,7 @@ inline void PopulateTradeResponses<Product>(
     Trader* trader,
     const std::vector<Trade<Product>>& trades,
     std::vector<std::pair<Trade<Product>, Product::Ptr>>& responses) {
+  ProfileScope prof(trader->manager(), "GetProductTrades");
   trader->GetProductTrades(trades, responses);
 }
 
@@ -83,6 +169,7 @@ template <>
 inline void AcceptTrades(
     Trader* trader,
     const std::vector<std::pair<Trade<Material>, Material::Ptr>>& responses) {
+  ProfileScope prof(trader->manager(), "AcceptMatlTrades");
   dynamic_cast<Trader*>(trader)->AcceptMatlTrades(responses);
 }
 
@@ -90,6 +177,7 @@ template <>
 inline void AcceptTrades(
     Trader* trader,
     const std::vector<std::pair<Trade<Product>, Product::Ptr>>& responses) {
+  ProfileScope prof(trader->manager(), "AcceptProductTrades");
   trader->AcceptProductTrades(responses);
 }
 
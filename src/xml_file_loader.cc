@@ -256,6 +256,7 @@ void XMLFileLoader::LoadSolver() {
   string config = "config";
   string greedy = "greedy";
   string coinor = "coin-or";
+  string mincostflow = "min-cost-flow";
   string solver_name = greedy;
   bool exclusive = ExchangeSolver::kDefaultExclusive;
   if (xqe.NMatches("/*/control/solver") == 1) {
@@ -294,10 +295,31 @@ void XMLFileLoader::LoadSolver() {
     bool verbose = cyclus::OptionalQuery<bool>(&xqe, query, false);
     query = string("/*/control/solver/config/coin-or/mps");
     bool mps = cyclus::OptionalQuery<bool>(&xqe, query, false);
+    query = string("/*/control/solver/config/coin-or/warm_start");
+    bool warm_start = cyclus::OptionalQuery<bool>(&xqe, query, false);
+    query = string("/*/control/solver/config/coin-or/greedy_start");
+    bool greedy_start = cyclus::OptionalQuery<bool>(&xqe, query, true);
+    query = string("/*/control/solver/config/coin-or/relax_and_round");
+    bool relax_and_round = cyclus::OptionalQuery<bool>(&xqe, query, false);
     ctx_->NewDatum("CoinSolverInfo")
         ->AddVal("Timeout", timeout)
         ->AddVal("Verbose", verbose)
         ->AddVal("Mps", mps)
+        ->AddVal("WarmStart", warm_start)
+        ->AddVal("GreedyStart", greedy_start)
+        ->AddVal("RelaxAndRound", relax_and_round)
+        ->Record();
+  } else if (solver_name == mincostflow) {
+    // the timeout applies to the COIN-OR fallback for exclusive orders
+    query = string("/*/control/solver/config/min-cost-flow/timeout");
+    double timeout = cyclus::OptionalQuery<double>(&xqe, query, -1);
+    ctx_->NewDatum("CoinSolverInfo")
+        ->AddVal("Timeout", timeout)
+        ->AddVal("Verbose", false)
+        ->AddVal("Mps", false)
+        ->AddVal("WarmStart", false)
+        ->AddVal("GreedyStart", true)
+        ->AddVal("RelaxAndRound", false)
         ->Record();
   } else {
     throw ValueError("unknown solver name: " + solver_name);
@@ -499,6 +521,9 @@ void XMLFileLoader::LoadControlParams() {
   si.explicit_inventory = OptionalQuery<bool>(qe, "explicit_inventory", false);
   si.explicit_inventory_compact =
       OptionalQuery<bool>(qe, "explicit_inventory_compact", false);
+  si.compact_decay_chains =
+      OptionalQuery<bool>(qe, "compact_decay_chains", false);
+  si.fast_forward = OptionalQuery<bool>(qe, "fast_forward", false);
 
   // get time step duration
   si.dt = OptionalQuery<int>(qe, "dt", kDefaultTimeStepDur);
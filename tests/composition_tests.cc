@@ -1,4 +1,5 @@
 #include <map>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -94,3 +95,97 @@ TEST(CompositionTests, decay) {
   EXPECT_NEAR(v[id("U238")], newv[id("U238")], 1e-4);
 }
 
+
+TEST(CompositionTests, decay_negligible) {
+  cyclus::Env::SetNucDataPath();
+
+  CompMap v;
+  v[id("U235")] = 1;
+  Composition::Ptr c = Composition::CreateFromAtom(v);
+
+  double lambda = pyne::decay_const(id("U235"));
+  EXPECT_DOUBLE_EQ(lambda, c->max_decay_const());
+  EXPECT_FALSE(c->IsStable());
+
+  double eps = 1e-3;
+  uint64_t secs_per_timestep = kDefaultTimeStepDur;
+  int threshold = static_cast<int>(-std::log(1 - eps) /
+                                   (lambda * secs_per_timestep));
+  EXPECT_TRUE(c->DecayNegligible(1, secs_per_timestep));
+  EXPECT_TRUE(c->DecayNegligible(threshold, secs_per_timestep));
+  EXPECT_FALSE(c->DecayNegligible(threshold + 1, secs_per_timestep));
+  EXPECT_TRUE(c->DecayNegligible(threshold / 12, 12 * secs_per_timestep));
+
+  CompMap stable;
+  stable[id("O16")] = 1;
+  Composition::Ptr o = Composition::CreateFromAtom(stable);
+  EXPECT_TRUE(o->IsStable());
+  EXPECT_TRUE(o->DecayNegligible(1000000, secs_per_timestep));
+}
+
+TEST(CompositionTests, derived_quantities) {
+  cyclus::Env::SetNucDataPath();
+
+  CompMap v;
+  v[id("U235")] = 3;
+  v[id("U238")] = 96;
+  v[id("Pu239")] = 1;
+  Composition::Ptr c = Composition::CreateFromMass(v);
+
+  CompMap norm = c->mass();
+  cyclus::compmath::Normalize(&norm);
+  EXPECT_TRUE(cyclus::compmath::AlmostEq(norm, c->mass_norm(), 1e-15));
+  norm = c->atom();
+  cyclus::compmath::Normalize(&norm);
+  EXPECT_TRUE(cyclus::compmath::AlmostEq(norm, c->atom_norm(), 1e-15));
+
+  EXPECT_DOUBLE_EQ(3.0 / 99.0, c->u235_assay_mass());
+  EXPECT_DOUBLE_EQ(c->atom_norm().at(id("U235")) /
+                       (c->atom_norm().at(id("U235")) +
+                        c->atom_norm().at(id("U238"))),
+                   c->u235_assay_atom());
+  EXPECT_DOUBLE_EQ(0.04, c->fissile_frac());
+
+  // repeated queries return the cached values
+  EXPECT_EQ(&c->mass_norm(), &c->mass_norm());
+  EXPECT_DOUBLE_EQ(3.0 / 99.0, c->u235_assay_mass());
+
+  CompMap o;
+  o[id("O16")] = 1;
+  Composition::Ptr oxygen = Composition::CreateFromMass(o);
+  EXPECT_DOUBLE_EQ(0, oxygen->u235_assay_mass());
+  EXPECT_DOUBLE_EQ(0, oxygen->fissile_frac());
+}
+
+TEST(CompositionTests, concurrent_queries) {
+  cyclus::Env::SetNucDataPath();
+
+  CompMap v;
+  v[id("U235")] = 3;
+  v[id("U238")] = 96;
+  v[id("Pu239")] = 1;
+  Composition::Ptr c = Composition::CreateFromMass(v);
+
+  // compositions are shared between agents that may run concurrently, so
+  // every lazily computed value must be computed exactly once
+  int n = 64;
+  std::vector<const CompMap*> norms(n);
+  std::vector<double> fracs(n);
+  std::vector<Composition::Ptr> decayed(n);
+  std::vector<int> negligible(n);
+#pragma omp parallel for
+  for (int i = 0; i < n; ++i) {
+    norms[i] = &c->mass_norm();
+    fracs[i] = c->fissile_frac();
+    decayed[i] = c->Decay(12);
+    negligible[i] = c->DecayNegligible(1, 1) ? 1 : 0;
+  }
+
+  for (int i = 0; i < n; ++i) {
+    EXPECT_EQ(norms[0], norms[i]);
+    EXPECT_DOUBLE_EQ(0.04, fracs[i]);
+    EXPECT_EQ(decayed[0], decayed[i]);
+    EXPECT_EQ(1, negligible[i]);
+  }
+  EXPECT_EQ(decayed[0], c->Decay(12));
+}
@@ -109,6 +109,31 @@ TEST_F(ContextTests, CreateAgent) {
   EXPECT_EQ(6, DonutShop::destruct_count);
 }
 
+TEST_F(ContextTests, CreateAgents) {
+  Timer ti;
+  Recorder rec;
+  Context* ctx = new Context(&ti, &rec);
+  DonutShop::destruct_count = 0;
+
+  Agent* m = new DonutShop(ctx, "old fashion");
+  ctx->AddPrototype("dunkin donuts", m);
+
+  std::vector<DonutShop*> ds;
+  ASSERT_NO_THROW(ctx->CreateAgents("dunkin donuts", 3, &ds));
+  ASSERT_EQ(3, ds.size());
+  for (int i = 0; i < ds.size(); ++i) {
+    EXPECT_EQ("old fashion", ds[i]->donut_of_the_day);
+    EXPECT_NE(ds[i], m);
+  }
+  EXPECT_NE(ds[0], ds[1]);
+
+  ASSERT_THROW(ctx->CreateAgents("krispy kreme", 1, &ds), cyclus::KeyError);
+  EXPECT_EQ(3, ds.size());
+
+  delete ctx;
+  EXPECT_EQ(4, DonutShop::destruct_count);
+}
+
 TEST_F(ContextTests, DoubleAgentNameThrow) {
   Timer ti;
   Recorder rec;
@@ -160,6 +160,11 @@ TEST_F(ExchangeContextTests, AddBid1) {
   bidders.insert(fac1);
   EXPECT_EQ(bidders, context.bidders);
 
+  // the nested preferences are only built on demand
+  EXPECT_TRUE(context.trader_prefs.empty());
+  std::set<Trader*> reqrs;
+  reqrs.insert(req1->requester());
+  context.BuildPrefs(reqrs);
   PrefMap<Resource>::type obs;
   obs[req1].insert(std::make_pair(bid, req1->preference()));
   EXPECT_EQ(context.trader_prefs[req1->requester()], obs);
@@ -224,3 +229,47 @@ TEST_F(ExchangeContextTests, AddBid2) {
   bidders.insert(fac2);
   EXPECT_EQ(bidders, context.bidders);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ExchangeContextTests, FlattenPrefs) {
+  ExchangeContext<Resource> context;
+  context.AddRequestPortfolio(rp1);
+  context.AddRequestPortfolio(rp2);
+
+  BidPortfolio<Resource>::Ptr bp(new BidPortfolio<Resource>());
+  Bid<Resource>* bid1 = bp->AddBid(req1, get_mat(), fac1);
+  Bid<Resource>* bid2 = bp->AddBid(req2, get_mat(), fac1);
+  context.AddBidPortfolio(bp);
+
+  // bids start out with their request's preference
+  ASSERT_EQ(2, context.flat_bids.size());
+  EXPECT_EQ(bid1, context.flat_bids[bid1->ordinal()]);
+  EXPECT_EQ(bid2, context.flat_bids[bid2->ordinal()]);
+  EXPECT_EQ(pref, context.Pref(bid1));
+  EXPECT_EQ(pref, context.Pref(bid2));
+
+  // only the requesters asked for get nested preferences
+  std::set<Trader*> reqrs;
+  reqrs.insert(fac2);
+  context.BuildPrefs(reqrs);
+  ASSERT_EQ(1, context.trader_prefs.size());
+  ASSERT_EQ(1, context.trader_prefs[fac2].size());
+  EXPECT_EQ(pref, context.trader_prefs[fac2][req2][bid2]);
+  context.trader_prefs[fac2][req2][bid2] = 2 * pref;
+  EXPECT_EQ(pref, context.Pref(bid2));
+  context.FlattenPrefs();
+  EXPECT_EQ(pref, context.Pref(bid1));
+  EXPECT_EQ(2 * pref, context.Pref(bid2));
+
+  BidPortfolio<Resource>::Ptr other(new BidPortfolio<Resource>());
+  Bid<Resource>* bid3 = other->AddBid(req1, get_mat(), fac2);
+  EXPECT_EQ(-1, bid3->ordinal());
+  EXPECT_THROW(context.Pref(bid3), cyclus::KeyError);
+
+  // a bid's ordinal only counts in the exchange it was last added to
+  ExchangeContext<Resource> next;
+  next.AddBidPortfolio(other);
+  EXPECT_EQ(0, bid3->ordinal());
+  EXPECT_THROW(context.Pref(bid3), cyclus::KeyError);
+  EXPECT_EQ(pref, next.Pref(bid3));
+}
@@ -5,6 +5,7 @@
 #include "exchange_graph.h"
 
 using cyclus::Arc;
+using cyclus::CompactGraph;
 using cyclus::ExchangeGraph;
 using cyclus::Match;
 using cyclus::ExchangeNode;
@@ -130,3 +131,243 @@ TEST(ExGraphTests, AddMatch) {
   ASSERT_EQ(1, g.matches().size());
   EXPECT_EQ(match, g.matches().at(0));
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExGraphTests, Compact) {
+  ExchangeNode::Ptr u(new ExchangeNode(5));
+  ExchangeNode::Ptr v(new ExchangeNode(3, true));
+  ExchangeNode::Ptr w(new ExchangeNode(4));
+  ExchangeNode::Ptr x(new ExchangeNode());
+
+  Arc a1(u, v);
+  Arc a2(u, w);
+  u->prefs[a1] = 2;
+  u->prefs[a2] = 1;
+  u->unit_capacities[a1].push_back(1);
+  u->unit_capacities[a1].push_back(2);
+  u->unit_capacities[a2].push_back(3);
+  u->unit_capacities[a2].push_back(4);
+  v->unit_capacities[a1].push_back(0.5);
+  w->unit_capacities[a2].push_back(0.25);
+
+  RequestGroup::Ptr rg(new RequestGroup(5));
+  rg->AddExchangeNode(u);
+  rg->AddCapacity(5);
+  rg->AddCapacity(10);
+  ExchangeNodeGroup::Ptr sg(new ExchangeNodeGroup());
+  sg->AddExchangeNode(v);
+  sg->AddExchangeNode(w);
+  sg->AddCapacity(6);
+
+  ExchangeGraph g;
+  g.AddRequestGroup(rg);
+  g.AddSupplyGroup(sg);
+  g.AddArc(a1);
+  g.AddArc(a2);
+
+  const CompactGraph& cg = g.compact();
+  ASSERT_EQ(3, cg.n_nodes());
+  ASSERT_EQ(2, cg.n_arcs());
+  ASSERT_EQ(2, cg.n_groups());
+  EXPECT_EQ(1, cg.n_request_groups);
+  EXPECT_EQ(0, cg.node_id(u.get()));
+  EXPECT_EQ(1, cg.node_id(v.get()));
+  EXPECT_EQ(2, cg.node_id(w.get()));
+  EXPECT_EQ(-1, cg.node_id(x.get()));
+  EXPECT_EQ(0, cg.group_id(rg.get()));
+  EXPECT_EQ(1, cg.group_id(sg.get()));
+  EXPECT_EQ(1, cg.node_group[2]);
+  EXPECT_EQ(4, cg.node_qty[2]);
+
+  // group capacities
+  EXPECT_EQ(2, cg.group_cap_start[1] - cg.group_cap_start[0]);
+  EXPECT_EQ(1, cg.group_cap_start[2] - cg.group_cap_start[1]);
+  EXPECT_EQ(10, cg.group_caps[cg.group_cap_start[0] + 1]);
+
+  // per-arc data
+  EXPECT_EQ(0, cg.arc_unode[1]);
+  EXPECT_EQ(2, cg.arc_vnode[1]);
+  EXPECT_EQ(2, cg.arc_pref[0]);
+  EXPECT_EQ(1, cg.arc_pref[1]);
+  EXPECT_TRUE(cg.arc_exclusive[0]);
+  EXPECT_FALSE(cg.arc_exclusive[1]);
+  EXPECT_EQ(a1.excl_val(), cg.arc_excl_val[0]);
+  EXPECT_EQ(2, cg.ucap_start[1] - cg.ucap_start[0]);
+  EXPECT_EQ(4, cg.ucaps[cg.ucap_start[1] + 1]);
+  EXPECT_EQ(0.25, cg.vcaps[cg.vcap_start[1]]);
+
+  // CSR adjacency
+  EXPECT_EQ(2, cg.adj_start[1] - cg.adj_start[0]);
+  EXPECT_EQ(0, cg.adj_arcs[cg.adj_start[0]]);
+  EXPECT_EQ(1, cg.adj_arcs[cg.adj_start[0] + 1]);
+  EXPECT_EQ(1, cg.adj_start[3] - cg.adj_start[2]);
+  EXPECT_EQ(1, cg.adj_arcs[cg.adj_start[2]]);
+
+  // rebuilt after the graph changes
+  Arc a3(x, w);
+  g.AddArc(a3);
+  EXPECT_EQ(3, g.compact().n_arcs());
+  EXPECT_EQ(3, g.compact().node_id(x.get()));
+  EXPECT_EQ(-1, g.compact().node_group[3]);
+  EXPECT_EQ(2, g.arc_ids().at(a3));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExGraphTests, CompactArcData) {
+  ExchangeNode::Ptr u1(new ExchangeNode());
+  ExchangeNode::Ptr u2(new ExchangeNode());
+  ExchangeNode::Ptr v1(new ExchangeNode());
+  ExchangeNode::Ptr v2(new ExchangeNode());
+  RequestGroup::Ptr r1(new RequestGroup());
+  r1->AddExchangeNode(u1);
+  RequestGroup::Ptr r2(new RequestGroup());
+  r2->AddExchangeNode(u2);
+  ExchangeNodeGroup::Ptr s1(new ExchangeNodeGroup());
+  s1->AddExchangeNode(v1);
+  ExchangeNodeGroup::Ptr s2(new ExchangeNodeGroup());
+  s2->AddExchangeNode(v2);
+
+  // a1 carries its data, a2 has it in its nodes' maps
+  Arc a1(u1, v1);
+  Arc a2(u2, v2);
+  u2->prefs[a2] = 3;
+  u2->unit_capacities[a2].push_back(4);
+  v2->unit_capacities[a2].push_back(5);
+
+  ExchangeGraph g;
+  g.AddRequestGroup(r1);
+  g.AddRequestGroup(r2);
+  g.AddSupplyGroup(s1);
+  g.AddSupplyGroup(s2);
+  g.AddArc(a1, 2, vector<double>(2, 0.5), vector<double>(1, 0.25));
+  g.AddArc(a2);
+  EXPECT_TRUE(u1->prefs.empty());
+  EXPECT_TRUE(u1->unit_capacities.empty());
+
+  const CompactGraph& cg = g.compact();
+  EXPECT_EQ(2, cg.arc_pref[0]);
+  EXPECT_EQ(3, cg.arc_pref[1]);
+  EXPECT_EQ(0, cg.ucap_start[0]);
+  EXPECT_EQ(2, cg.ucap_start[1]);
+  EXPECT_EQ(3, cg.ucap_start[2]);
+  EXPECT_EQ(0.5, cg.ucaps[1]);
+  EXPECT_EQ(4, cg.ucaps[2]);
+  EXPECT_EQ(0.25, cg.vcaps[0]);
+  EXPECT_EQ(5, cg.vcaps[1]);
+  EXPECT_EQ(1, cg.arc_id(cg.node_id(u2.get()), cg.node_id(v2.get())));
+  EXPECT_EQ(-1, cg.arc_id(cg.node_id(u1.get()), cg.node_id(v2.get())));
+
+  // components take the data from the compact graph, so later changes to the
+  // maps do not reach them
+  u2->prefs[a2] = 7;
+  vector<ExchangeGraph::Ptr> comps = g.Components();
+  ASSERT_EQ(2, comps.size());
+  const CompactGraph& c1 = comps[1]->compact();
+  ASSERT_EQ(1, c1.n_arcs());
+  EXPECT_EQ(3, c1.arc_pref[0]);
+  EXPECT_EQ(4, c1.ucaps[0]);
+  EXPECT_EQ(5, c1.vcaps[0]);
+  EXPECT_EQ(0.5, comps[0]->compact().ucaps[1]);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExGraphTests, Components) {
+  ExchangeNode::Ptr u1(new ExchangeNode());
+  ExchangeNode::Ptr u2(new ExchangeNode());
+  ExchangeNode::Ptr u3(new ExchangeNode());
+  ExchangeNode::Ptr u4(new ExchangeNode());
+  ExchangeNode::Ptr v1(new ExchangeNode());
+  ExchangeNode::Ptr v2(new ExchangeNode());
+  ExchangeNode::Ptr v3(new ExchangeNode());
+
+  RequestGroup::Ptr r1(new RequestGroup());
+  r1->AddExchangeNode(u1);
+  RequestGroup::Ptr r2(new RequestGroup());
+  r2->AddExchangeNode(u2);
+  RequestGroup::Ptr r3(new RequestGroup());
+  r3->AddExchangeNode(u3);
+  RequestGroup::Ptr r4(new RequestGroup());
+  r4->AddExchangeNode(u4);
+  ExchangeNodeGroup::Ptr s1(new ExchangeNodeGroup());
+  s1->AddExchangeNode(v1);
+  ExchangeNodeGroup::Ptr s2(new ExchangeNodeGroup());
+  s2->AddExchangeNode(v2);
+  s2->AddExchangeNode(v3);
+
+  // r2, r4 and s2 form one market, r1 and s1 another, r3 has no arcs
+  Arc a1(u2, v2);
+  Arc a2(u1, v1);
+  Arc a3(u4, v3);
+
+  ExchangeGraph g;
+  g.AddRequestGroup(r1);
+  g.AddRequestGroup(r2);
+  g.AddRequestGroup(r3);
+  g.AddRequestGroup(r4);
+  g.AddSupplyGroup(s1);
+  g.AddSupplyGroup(s2);
+  g.AddArc(a1);
+  g.AddArc(a2);
+  g.AddArc(a3);
+
+  vector<ExchangeGraph::Ptr> comps = g.Components();
+  ASSERT_EQ(2, comps.size());
+
+  vector<RequestGroup::Ptr> rexp;
+  rexp.push_back(r2);
+  rexp.push_back(r4);
+  EXPECT_EQ(rexp, comps[0]->request_groups());
+  ASSERT_EQ(1, comps[0]->supply_groups().size());
+  EXPECT_EQ(s2, comps[0]->supply_groups()[0]);
+  vector<Arc> aexp;
+  aexp.push_back(a1);
+  aexp.push_back(a3);
+  EXPECT_EQ(aexp, comps[0]->arcs());
+
+  ASSERT_EQ(1, comps[1]->request_groups().size());
+  EXPECT_EQ(r1, comps[1]->request_groups()[0]);
+  ASSERT_EQ(1, comps[1]->supply_groups().size());
+  EXPECT_EQ(s1, comps[1]->supply_groups()[0]);
+  ASSERT_EQ(1, comps[1]->arcs().size());
+  EXPECT_EQ(a2, comps[1]->arcs()[0]);
+}
+
+//- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExGraphTests, ArcKeys) {
+  ExchangeNode::Ptr u1(new ExchangeNode(1, false, "c", 1));
+  ExchangeNode::Ptr u2(new ExchangeNode(1, false, "c", 1));
+  ExchangeNode::Ptr u3(new ExchangeNode(1, false, "d", 1));
+  ExchangeNode::Ptr v1(new ExchangeNode(1, false, "c", 2));
+  ExchangeNode::Ptr v2(new ExchangeNode(1, false, "c", 2));
+  ExchangeNode::Ptr v3(new ExchangeNode(1, false, "d", 2));
+
+  RequestGroup::Ptr r(new RequestGroup());
+  r->AddExchangeNode(u1);
+  r->AddExchangeNode(u2);
+  r->AddExchangeNode(u3);
+  ExchangeNodeGroup::Ptr s(new ExchangeNodeGroup());
+  s->AddExchangeNode(v1);
+  s->AddExchangeNode(v2);
+  s->AddExchangeNode(v3);
+
+  ExchangeGraph g;
+  g.AddRequestGroup(r);
+  g.AddSupplyGroup(s);
+  g.AddArc(Arc(u1, v1));
+  g.AddArc(Arc(u3, v3));
+  g.AddArc(Arc(u2, v2));
+
+  // arcs between the same agents for the same commodity are numbered
+  vector<cyclus::ArcKey> keys = cyclus::ArcKeys(g);
+  ASSERT_EQ(3, keys.size());
+  EXPECT_EQ(1, keys[0].requester);
+  EXPECT_EQ(2, keys[0].bidder);
+  EXPECT_EQ("c", keys[0].commod);
+  EXPECT_EQ(0, keys[0].n);
+  EXPECT_EQ("d", keys[1].commod);
+  EXPECT_EQ(0, keys[1].n);
+  EXPECT_EQ("c", keys[2].commod);
+  EXPECT_EQ(1, keys[2].n);
+  EXPECT_TRUE(keys[0] < keys[2]);
+  EXPECT_FALSE(keys[0] == keys[2]);
+}
@@ -3,6 +3,7 @@
 #include "exchange_manager.h"
 #include "greedy_solver.h"
 #include "material.h"
+#include "rec_backend.h"
 #include "test_context.h"
 
 using cyclus::ExchangeManager;
@@ -10,6 +11,25 @@ using cyclus::GreedySolver;
 using cyclus::Material;
 using cyclus::TestContext;
 
+namespace {
+
+// keeps the titles of all recorded datums
+class TitleBack : public cyclus::RecBackend {
+ public:
+  virtual void Notify(cyclus::DatumList data) {
+    for (int i = 0; i != data.size(); ++i) {
+      titles.push_back(data[i]->title());
+    }
+  }
+  virtual std::string Name() { return "TitleBack"; }
+  virtual void Flush() {}
+  virtual void Close() {}
+
+  std::vector<std::string> titles;
+};
+
+}  // namespace
+
 TEST(ExManagerTests, NullTest) {
   TestContext tc;
   GreedySolver* solver = new GreedySolver();
@@ -18,3 +38,23 @@ TEST(ExManagerTests, NullTest) {
 
   EXPECT_NO_THROW(manager.Execute());
 }
+
+TEST(ExManagerTests, Profile) {
+  TitleBack back;  // outlives the recorder
+  TestContext tc;
+  tc.recorder()->RegisterBackend(&back);
+  tc.get()->solver(new GreedySolver());
+
+  ExchangeManager<Material> quiet(tc.get());
+  quiet.Execute();
+  tc.recorder()->Flush();
+  EXPECT_EQ(0, std::count(back.titles.begin(), back.titles.end(),
+                          "ExchangeProfile"));
+
+  tc.get()->profiler()->enabled(true);
+  ExchangeManager<Material> manager(tc.get());
+  manager.Execute();
+  tc.recorder()->Flush();
+  EXPECT_EQ(1, std::count(back.titles.begin(), back.titles.end(),
+                          "ExchangeProfile"));
+}
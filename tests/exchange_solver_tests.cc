@@ -1,8 +1,16 @@
 #include <gtest/gtest.h>
 
+#include "exchange_graph.h"
 #include "exchange_solver.h"
+#include "platform.h"
 
+using cyclus::Arc;
+using cyclus::ExchangeGraph;
+using cyclus::ExchangeNode;
+using cyclus::ExchangeNodeGroup;
 using cyclus::ExchangeSolver;
+using cyclus::Match;
+using cyclus::RequestGroup;
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class MockSolver: public ExchangeSolver {
@@ -14,6 +22,74 @@ class MockSolver: public ExchangeSolver {
   int i;
 };
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// matches every arc of the graph it solves with a quantity of 1
+class MatchAllSolver: public ExchangeSolver {
+ public:
+  explicit MatchAllSolver(int* nsolves) : nsolves_(nsolves) {}
+
+  virtual ExchangeSolver* Clone() const {
+    return new MatchAllSolver(nsolves_);
+  }
+
+  virtual double SolveGraph() {
+#if CYCLUS_IS_PARALLEL
+#pragma omp atomic
+#endif
+    ++(*nsolves_);
+    for (int i = 0; i < graph_->arcs().size(); ++i) {
+      graph_->AddMatch(graph_->arcs()[i], 1);
+    }
+    return graph_->arcs().size();
+  }
+
+  int* nsolves_;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// records which solver instance solved each component
+class RecordingSolver: public ExchangeSolver {
+ public:
+  explicit RecordingSolver(std::vector<const ExchangeSolver*>* solved_by)
+      : solved_by_(solved_by) {
+    ++live;
+  }
+
+  virtual ~RecordingSolver() { --live; }
+
+  virtual ExchangeSolver* Clone() const {
+    return new RecordingSolver(solved_by_);
+  }
+
+  virtual double SolveGraph() {
+    (*solved_by_)[component()] = this;
+    return 0;
+  }
+
+  std::vector<const ExchangeSolver*>* solved_by_;
+
+  // the number of instances alive
+  static int live;
+};
+
+int RecordingSolver::live = 0;
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a graph with one single-arc component per requester id, in order
+void BuildComponents(ExchangeGraph* g, const std::vector<int>& ids) {
+  for (int i = 0; i < ids.size(); ++i) {
+    ExchangeNode::Ptr u(new ExchangeNode(1, false, "commod", ids[i]));
+    ExchangeNode::Ptr v(new ExchangeNode(1, false, "commod", 100));
+    RequestGroup::Ptr r(new RequestGroup());
+    r->AddExchangeNode(u);
+    ExchangeNodeGroup::Ptr s(new ExchangeNodeGroup());
+    s->AddExchangeNode(v);
+    g->AddRequestGroup(r);
+    g->AddSupplyGroup(s);
+    g->AddArc(Arc(u, v));
+  }
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TEST(ExSolverTests, Interface) {
   MockSolver s;
@@ -23,3 +99,95 @@ TEST(ExSolverTests, Interface) {
   s.Solve();
   EXPECT_EQ(2, s.i);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExSolverTests, SolveComponents) {
+  ExchangeGraph g;
+  std::vector<Arc> arcs;
+  for (int i = 0; i < 3; ++i) {
+    ExchangeNode::Ptr u(new ExchangeNode());
+    ExchangeNode::Ptr v(new ExchangeNode());
+    RequestGroup::Ptr r(new RequestGroup());
+    r->AddExchangeNode(u);
+    ExchangeNodeGroup::Ptr s(new ExchangeNodeGroup());
+    s->AddExchangeNode(v);
+    g.AddRequestGroup(r);
+    g.AddSupplyGroup(s);
+    arcs.push_back(Arc(u, v));
+  }
+  // add the arcs in reverse so that component order differs from group order
+  for (int i = 2; i >= 0; --i) {
+    g.AddArc(arcs[i]);
+  }
+
+  int nsolves = 0;
+  MatchAllSolver s(&nsolves);
+  EXPECT_EQ(3, s.SolveComponents(&g));
+  EXPECT_EQ(3, nsolves);
+  EXPECT_EQ(&g, s.graph());
+  ASSERT_EQ(3, g.matches().size());
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(Match(arcs[2 - i], 1), g.matches()[i]);
+  }
+
+  // solvers that cannot be cloned solve components in turn
+  MockSolver m;
+  g.ClearMatches();
+  m.SolveComponents(&g);
+  EXPECT_EQ(3, m.i);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExSolverTests, ReuseComponentSolvers) {
+  std::vector<const ExchangeSolver*> solved_by(3, NULL);
+  RecordingSolver s(&solved_by);
+  std::vector<int> ids;
+  ids.push_back(1);
+  ids.push_back(2);
+  ExchangeGraph g1;
+  BuildComponents(&g1, ids);
+  s.SolveComponents(&g1);
+  std::vector<const ExchangeSolver*> first = solved_by;
+  EXPECT_NE(first[0], first[1]);
+  EXPECT_NE(static_cast<const ExchangeSolver*>(&s), first[0]);
+  EXPECT_NE(static_cast<const ExchangeSolver*>(&s), first[1]);
+
+  // the same components are solved by the same solvers, even when their
+  // indices change
+  ids.insert(ids.begin(), 0);
+  ExchangeGraph g2;
+  BuildComponents(&g2, ids);
+  s.SolveComponents(&g2);
+  EXPECT_NE(first[0], solved_by[0]);
+  EXPECT_NE(first[1], solved_by[0]);
+  EXPECT_EQ(first[0], solved_by[1]);
+  EXPECT_EQ(first[1], solved_by[2]);
+  EXPECT_EQ(-1, s.component());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExSolverTests, ReuseSameLookingComponents) {
+  // components 0 and 1 have the same arcs; each keeps its own solver
+  std::vector<const ExchangeSolver*> solved_by(3, NULL);
+  {
+    RecordingSolver s(&solved_by);
+    std::vector<int> ids;
+    ids.push_back(1);
+    ids.push_back(1);
+    ids.push_back(2);
+    ExchangeGraph g1;
+    BuildComponents(&g1, ids);
+    s.SolveComponents(&g1);
+    std::vector<const ExchangeSolver*> first = solved_by;
+    EXPECT_NE(first[0], first[1]);
+    EXPECT_NE(first[1], first[2]);
+    EXPECT_EQ(4, RecordingSolver::live);
+
+    ExchangeGraph g2;
+    BuildComponents(&g2, ids);
+    s.SolveComponents(&g2);
+    EXPECT_EQ(first, solved_by);
+    EXPECT_EQ(4, RecordingSolver::live);
+  }
+  EXPECT_EQ(0, RecordingSolver::live);
+}
@@ -77,6 +77,28 @@ struct MatConverter2 : public Converter<Material> {
   }
 };
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a composition-dependent, linear converter that counts its evaluations
+struct CountingConverter : public Converter<Material> {
+  explicit CountingConverter(int* calls) : calls(calls) {}
+
+  virtual double convert(
+      Material::Ptr r,
+      Arc const * a = NULL,
+      ExchangeTranslationContext<Material> const *  ctx = NULL) const {
+    ++*calls;
+    return r->quantity() * r->comp()->mass().begin()->second;
+  }
+
+  virtual bool operator==(Converter<Material>& other) const {
+    return dynamic_cast<CountingConverter*>(&other) != NULL;
+  }
+
+  virtual bool memoizable() const { return true; }
+
+  int* calls;
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TEST(ExXlateTests, NegPref) {
   TestContext tc;
@@ -420,6 +442,14 @@ TEST(ExXlateTests, SimpleXlate) {
   ctx.AddRequestPortfolio(rport);
   ctx.AddBidPortfolio(bport);
 
+  // preferences adjusted after the bids were added are translated
+  pref *= 2;
+  std::set<cyclus::Trader*> reqrs;
+  reqrs.insert(trader);
+  ctx.BuildPrefs(reqrs);
+  ctx.trader_prefs[trader][req][*bport->bids().begin()] = pref;
+  ctx.FlattenPrefs();
+
   ExchangeTranslator<Material> xlator(&ctx);
 
   ExchangeGraph::Ptr graph;
@@ -430,7 +460,19 @@ TEST(ExXlateTests, SimpleXlate) {
   EXPECT_EQ(1, graph->arcs().size());
   EXPECT_EQ(0, graph->matches().size());
   const Arc& a = *graph->arcs().begin();
-  EXPECT_EQ(pref, a.unode()->prefs[a]);
+  EXPECT_EQ(pref, a.pref());
+
+  // arc data goes to the compact graph only
+  EXPECT_TRUE(a.unode()->prefs.empty());
+  EXPECT_TRUE(a.unode()->unit_capacities.empty());
+  EXPECT_TRUE(a.vnode()->unit_capacities.empty());
+
+  const cyclus::CompactGraph& cg = graph->compact();
+  ASSERT_EQ(1, cg.n_arcs());
+  EXPECT_EQ(2, cg.n_nodes());
+  EXPECT_EQ(cg.node_id(a.unode().get()), cg.arc_unode[0]);
+  EXPECT_EQ(cg.node_id(a.vnode().get()), cg.arc_vnode[0]);
+  EXPECT_DOUBLE_EQ(pref, cg.arc_pref[0]);
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -478,3 +520,43 @@ TEST(ExXlateTests, BackXlate) {
   xlator.BackTranslateSolution(matches, obs);
   EXPECT_EQ(exp, obs);
 }
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ExXlateTests, MemoizedCapacities) {
+  int calls = 0;
+  Converter<Material>::Ptr c1(new CountingConverter(&calls));
+  Converter<Material>::Ptr c2(new CountingConverter(&calls));
+  CapacityConstraint<Material> cc1(qty, c1);
+  CapacityConstraint<Material> cc2(qty, c2);
+  std::set< CapacityConstraint<Material> > constrs;
+  constrs.insert(cc1);
+  std::set< CapacityConstraint<Material> > other_constrs;
+  other_constrs.insert(cc2);
+
+  CompMap cm;
+  cm[u235] = 0.5;
+  Composition::Ptr comp = Composition::CreateFromMass(cm);
+  Material::Ptr small = Material::CreateUntracked(2, comp);
+  Material::Ptr large = Material::CreateUntracked(6, comp);
+  cm[u235] = 0.25;
+  Material::Ptr other =
+      Material::CreateUntracked(2, Composition::CreateFromMass(cm));
+
+  // every translation appends to the unit capacities of the same arc
+  ExchangeNode::Ptr u(new ExchangeNode());
+  Arc a(u, ExchangeNode::Ptr(new ExchangeNode()));
+
+  ExchangeTranslationContext<Material> ctx;
+  cyclus::TranslateCapacities<Material>(small, constrs, u, a, ctx);
+  EXPECT_EQ(1, calls);
+  cyclus::TranslateCapacities<Material>(large, constrs, u, a, ctx);
+  cyclus::TranslateCapacities<Material>(large, other_constrs, u, a, ctx);
+  EXPECT_EQ(1, calls);
+  std::vector<double> exp(3, 0.5);
+  EXPECT_EQ(exp, u->unit_capacities[a]);
+
+  // a new composition is converted
+  cyclus::TranslateCapacities<Material>(other, constrs, u, a, ctx);
+  EXPECT_EQ(2, calls);
+  EXPECT_DOUBLE_EQ(0.25, u->unit_capacities[a][3]);
+}
@@ -88,6 +88,7 @@ TEST(ConditionerTests, Conditioning) {
   EXPECT_EQ(g.request_groups().at(1), g2);
   EXPECT_EQ(g.request_groups().at(1)->nodes().at(0), n21);
   EXPECT_EQ(g.request_groups().at(1)->nodes().at(1), n22);
+  EXPECT_EQ(0, g.compact().node_id(n11.get()));
 
   std::map<std::string, double> weights;
   weights["spam"] = 5.;
@@ -134,4 +135,8 @@ TEST(ConditionerTests, Conditioning) {
   EXPECT_EQ(g.request_groups().at(1)->nodes().at(0), n12);
   EXPECT_EQ(g.request_groups().at(1)->nodes().at(1), n11);
   EXPECT_EQ(g.request_groups().at(1)->nodes().at(2), n13);
+
+  // reordering leaves the ids of the compact representation unchanged
+  EXPECT_EQ(4, g.compact().node_id(n22.get()));
+  EXPECT_EQ(1, g.compact().node_id(n12.get()));
 }
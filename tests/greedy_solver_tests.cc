@@ -67,6 +67,8 @@ TEST(GreedySolverTests, General) {
   g.AddRequestGroup(gu1);
   g.AddRequestGroup(gu2);
   g.AddSupplyGroup(gv);
+  g.AddArc(a1);
+  g.AddArc(a2);
 
   EXPECT_EQ(g.request_groups()[0], gu1);
   EXPECT_EQ(g.request_groups()[1], gu2);
@@ -0,0 +1,155 @@
+#include <set>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "composition.h"
+#include "error.h"
+#include "id_allocator.h"
+#include "material.h"
+
+using cyclus::IdAllocator;
+using cyclus::ParallelIdPhase;
+
+TEST(IdAllocatorTests, Serial) {
+  IdAllocator ids(5);
+  EXPECT_EQ(5, ids.Next());
+  EXPECT_EQ(6, ids.Next());
+  EXPECT_EQ(7, ids.next());
+  ids.Reset(42);
+  EXPECT_EQ(42, ids.Next());
+}
+
+TEST(IdAllocatorTests, PhaseIsOrderIndependent) {
+  int bs = IdAllocator::block_size();
+  IdAllocator::block_size(2);
+
+  // slot i creates i+1 ids; visit the slots in two different orders
+  std::vector<std::vector<int> > fwd(3);
+  std::vector<std::vector<int> > rev(3);
+  IdAllocator a(10);
+  IdAllocator b(10);
+  {
+    ParallelIdPhase phase(3);
+    for (int i = 0; i < 3; ++i) {
+      ParallelIdPhase::EnterSlot(i);
+      for (int j = 0; j <= i; ++j) {
+        fwd[i].push_back(a.Next());
+      }
+      ParallelIdPhase::LeaveSlot();
+    }
+    for (int i = 2; i >= 0; --i) {
+      ParallelIdPhase::EnterSlot(i);
+      for (int j = 0; j <= i; ++j) {
+        rev[i].push_back(b.Next());
+      }
+      ParallelIdPhase::LeaveSlot();
+    }
+  }
+  EXPECT_EQ(fwd, rev);
+
+  // level 0 holds one id for each of the 3 slots and the unslotted block
+  // (10-13), level 1 two ids each (14-21)
+  EXPECT_EQ(10, fwd[0][0]);
+  EXPECT_EQ(11, fwd[1][0]);
+  EXPECT_EQ(16, fwd[1][1]);
+  EXPECT_EQ(12, fwd[2][0]);
+  EXPECT_EQ(18, fwd[2][1]);
+  EXPECT_EQ(19, fwd[2][2]);
+
+  // the shared counter resumes after the largest id used
+  EXPECT_EQ(20, a.Next());
+  EXPECT_EQ(20, b.Next());
+
+  IdAllocator::block_size(bs);
+}
+
+TEST(IdAllocatorTests, PhaseUnslotted) {
+  // ids drawn outside of the slots while a phase is open are not handed out
+  // again, neither by the slots nor after the phase
+  IdAllocator a(1);
+  std::set<int> got;
+  {
+    ParallelIdPhase phase(2);
+    got.insert(a.Next());
+    ParallelIdPhase::EnterSlot(1);
+    got.insert(a.Next());
+    ParallelIdPhase::LeaveSlot();
+    got.insert(a.Next());
+    got.insert(a.Next());
+  }
+  EXPECT_EQ(4, got.size());
+  EXPECT_EQ(2, *got.begin());
+  EXPECT_EQ(*got.rbegin() + 1, a.Next());
+}
+
+TEST(IdAllocatorTests, PhaseIsThreadSafe) {
+  // a parallel loop hands out the same ids as visiting the slots in order
+  int nslots = 200;
+  IdAllocator a(1);
+  IdAllocator b(1);
+  std::vector<std::vector<int> > par(nslots);
+  std::vector<std::vector<int> > ser(nslots);
+  {
+    ParallelIdPhase phase(nslots);
+#pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < nslots; ++i) {
+      ParallelIdPhase::EnterSlot(i);
+      for (int j = 0; j < i % 7; ++j) {
+        par[i].push_back(a.Next());
+      }
+      ParallelIdPhase::LeaveSlot();
+    }
+    for (int i = 0; i < nslots; ++i) {
+      ParallelIdPhase::EnterSlot(i);
+      for (int j = 0; j < i % 7; ++j) {
+        ser[i].push_back(b.Next());
+      }
+      ParallelIdPhase::LeaveSlot();
+    }
+  }
+  EXPECT_EQ(ser, par);
+
+  std::set<int> all;
+  int n = 0;
+  for (int i = 0; i < nslots; ++i) {
+    all.insert(par[i].begin(), par[i].end());
+    n += par[i].size();
+  }
+  EXPECT_EQ(n, all.size());
+  EXPECT_EQ(*all.rbegin() + 1, a.Next());
+}
+
+TEST(IdAllocatorTests, Errors) {
+  EXPECT_THROW(IdAllocator::block_size(0), cyclus::ValueError);
+  ParallelIdPhase phase(2);
+  EXPECT_THROW(ParallelIdPhase nested(2), cyclus::StateError);
+}
+
+TEST(IdAllocatorTests, ResourceIds) {
+  cyclus::CompMap v;
+  v[922350000] = 1;
+  cyclus::Composition::Ptr c = cyclus::Composition::CreateFromMass(v);
+
+  std::vector<int> fwd(4);
+  std::vector<int> rev(4);
+  int start = cyclus::Material::CreateUntracked(1, c)->obj_id() + 1;
+  {
+    ParallelIdPhase phase(4);
+    for (int i = 0; i < 4; ++i) {
+      ParallelIdPhase::EnterSlot(i);
+      fwd[i] = cyclus::Material::CreateUntracked(1, c)->obj_id() - start;
+      ParallelIdPhase::LeaveSlot();
+    }
+  }
+  start = cyclus::Material::CreateUntracked(1, c)->obj_id() + 1;
+  {
+    ParallelIdPhase phase(4);
+    for (int i = 3; i >= 0; --i) {
+      ParallelIdPhase::EnterSlot(i);
+      rev[i] = cyclus::Material::CreateUntracked(1, c)->obj_id() - start;
+      ParallelIdPhase::LeaveSlot();
+    }
+  }
+  EXPECT_EQ(fwd, rev);
+}
@@ -0,0 +1,146 @@
+#include <gtest/gtest.h>
+
+#include "exchange_graph.h"
+#include "greedy_solver.h"
+#include "min_cost_flow_solver.h"
+
+using cyclus::Arc;
+using cyclus::ExchangeGraph;
+using cyclus::ExchangeNode;
+using cyclus::ExchangeNodeGroup;
+using cyclus::GreedySolver;
+using cyclus::Match;
+using cyclus::MinCostFlowSolver;
+using cyclus::RequestGroup;
+
+namespace {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// r1 prefers s1 slightly over s2, r2 can only be supplied by s1. The greedy
+// solver serves r1 first (from s1) and leaves r2 unmet, while the optimal
+// solution serves r1 from s2 and r2 from s1.
+void Construct(ExchangeGraph* g, bool exclusive) {
+  double qty = 5;
+  ExchangeNode::Ptr u1_1(new ExchangeNode(qty, exclusive));
+  ExchangeNode::Ptr u1_2(new ExchangeNode(qty, exclusive));
+  ExchangeNode::Ptr u2(new ExchangeNode(qty, exclusive));
+  ExchangeNode::Ptr v1_1(new ExchangeNode(qty));
+  ExchangeNode::Ptr v1_2(new ExchangeNode(qty));
+  ExchangeNode::Ptr v2(new ExchangeNode(qty));
+  Arc a1(u1_1, v1_1);
+  Arc a2(u1_2, v2);
+  Arc a3(u2, v1_2);
+
+  u1_1->prefs[a1] = 2;
+  u1_2->prefs[a2] = 1.9;
+  u2->prefs[a3] = 1;
+  u1_1->unit_capacities[a1].push_back(1);
+  u1_2->unit_capacities[a2].push_back(1);
+  u2->unit_capacities[a3].push_back(1);
+  v1_1->unit_capacities[a1].push_back(1);
+  v1_2->unit_capacities[a3].push_back(1);
+  v2->unit_capacities[a2].push_back(1);
+
+  RequestGroup::Ptr r1(new RequestGroup(qty));
+  r1->AddCapacity(qty);
+  r1->AddExchangeNode(u1_1);
+  r1->AddExchangeNode(u1_2);
+  g->AddRequestGroup(r1);
+
+  RequestGroup::Ptr r2(new RequestGroup(qty));
+  r2->AddCapacity(qty);
+  r2->AddExchangeNode(u2);
+  g->AddRequestGroup(r2);
+
+  ExchangeNodeGroup::Ptr s1(new ExchangeNodeGroup());
+  s1->AddCapacity(qty);
+  s1->AddExchangeNode(v1_1);
+  s1->AddExchangeNode(v1_2);
+  g->AddSupplyGroup(s1);
+
+  ExchangeNodeGroup::Ptr s2(new ExchangeNodeGroup());
+  s2->AddCapacity(qty);
+  s2->AddExchangeNode(v2);
+  g->AddSupplyGroup(s2);
+
+  g->AddArc(a1);
+  g->AddArc(a2);
+  g->AddArc(a3);
+}
+
+}  // namespace
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(MinCostFlowSolverTests, BeatsGreedy) {
+  bool excl = false;
+  ExchangeGraph greedy_g;
+  Construct(&greedy_g, excl);
+  GreedySolver greedy(excl);
+  greedy.Solve(&greedy_g);
+  ASSERT_EQ(1, greedy_g.matches().size());
+  EXPECT_EQ(Match(greedy_g.arcs()[0], 5), greedy_g.matches()[0]);
+
+  ExchangeGraph g;
+  Construct(&g, excl);
+  MinCostFlowSolver s(excl);
+  double obj = s.Solve(&g);
+  EXPECT_FALSE(s.used_fallback());
+
+  std::vector<Match> vexp;
+  vexp.push_back(Match(g.arcs()[1], 5));
+  vexp.push_back(Match(g.arcs()[2], 5));
+  EXPECT_EQ(vexp, g.matches());
+  EXPECT_DOUBLE_EQ(5 / 1.9 + 5, obj);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(MinCostFlowSolverTests, UnitCapacities) {
+  ExchangeNode::Ptr u(new ExchangeNode(10));
+  ExchangeNode::Ptr v(new ExchangeNode());
+  Arc a(u, v);
+  u->prefs[a] = 1;
+  u->unit_capacities[a].push_back(2);
+  v->unit_capacities[a].push_back(4);
+
+  // the request is met by 5 units, the supply by 3
+  RequestGroup::Ptr r(new RequestGroup(10));
+  r->AddCapacity(10);
+  r->AddExchangeNode(u);
+  ExchangeNodeGroup::Ptr s(new ExchangeNodeGroup());
+  s->AddCapacity(12);
+  s->AddExchangeNode(v);
+
+  ExchangeGraph g;
+  g.AddRequestGroup(r);
+  g.AddSupplyGroup(s);
+  g.AddArc(a);
+
+  MinCostFlowSolver solver(false);
+  double obj = solver.Solve(&g);
+  EXPECT_FALSE(solver.used_fallback());
+  ASSERT_EQ(1, g.matches().size());
+  EXPECT_EQ(Match(a, 3), g.matches()[0]);
+
+  // 3 units are traded at cost 1, the remaining 4 units of the request's
+  // capacity are unmet
+  EXPECT_DOUBLE_EQ(3 + 4 * 1.1, obj);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(MinCostFlowSolverTests, Fallback) {
+  bool excl = true;
+  ExchangeGraph g;
+  Construct(&g, excl);
+  MinCostFlowSolver s(excl, new GreedySolver(excl));
+  s.Solve(&g);
+  EXPECT_TRUE(s.used_fallback());
+  EXPECT_FALSE(g.matches().empty());
+
+  // exclusive arcs are ordinary arcs if exclusive orders are not allowed
+  ExchangeGraph h;
+  Construct(&h, excl);
+  MinCostFlowSolver t(!excl, new GreedySolver(!excl));
+  t.Solve(&h);
+  EXPECT_FALSE(t.used_fallback());
+  EXPECT_EQ(2, h.matches().size());
+}
@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <boost/filesystem.hpp>
+
+#include "profiler.h"
+#include "rec_backend.h"
+#include "test_context.h"
+
+using cyclus::Profiler;
+using cyclus::TestContext;
+
+namespace {
+
+// collects the agent ids of recorded Profile rows
+class ProfileBack : public cyclus::RecBackend {
+ public:
+  virtual void Notify(cyclus::DatumList data) {
+    for (int i = 0; i != data.size(); ++i) {
+      if (data[i]->title() == "Profile") {
+        agents.push_back(data[i]->vals()[1].second.cast<int>());
+      }
+    }
+  }
+  virtual std::string Name() { return "ProfileBack"; }
+  virtual void Flush() {}
+  virtual void Close() {}
+
+  std::vector<int> agents;
+};
+
+std::string ReadFile(const std::string& path) {
+  std::ifstream in(path.c_str());
+  std::stringstream ss;
+  ss << in.rdbuf();
+  return ss.str();
+}
+
+int Count(const std::string& s, const std::string& sub) {
+  int n = 0;
+  for (size_t pos = s.find(sub); pos != std::string::npos;
+       pos = s.find(sub, pos + 1)) {
+    ++n;
+  }
+  return n;
+}
+
+}  // namespace
+
+TEST(ProfilerTests, FlushPerTimeStep) {
+  std::string trace = "profiler_tests_trace.json";
+  ProfileBack back;  // outlives the recorder
+  TestContext tc;
+  tc.recorder()->RegisterBackend(&back);
+  Profiler* prof = tc.get()->profiler();
+  prof->enabled(true);
+  prof->trace_file(trace);
+
+  Profiler::Clock::time_point t = Profiler::Clock::now();
+  prof->Add("Tick", 0, -1, t, t);
+  prof->Add("Tick", 0, 7, t, t);
+
+  // a flush records the phases and traces the calls so far, but keeps the
+  // agent totals
+  prof->Flush(tc.get());
+  tc.recorder()->Flush();
+  ASSERT_EQ(1, back.agents.size());
+  EXPECT_EQ(-1, back.agents[0]);
+  std::string partial = ReadFile(trace);
+  EXPECT_EQ(2, Count(partial, "\"name\": \"Tick\""));
+  EXPECT_EQ(0, Count(partial, "displayTimeUnit"));
+
+  prof->Add("Tick", 1, -1, t, t);
+  prof->Add("Tick", 1, 7, t, t);
+  prof->Record(tc.get());
+  tc.recorder()->Flush();
+  ASSERT_EQ(3, back.agents.size());
+  EXPECT_EQ(-1, back.agents[1]);
+  EXPECT_EQ(7, back.agents[2]);
+  std::string full = ReadFile(trace);
+  EXPECT_EQ(4, Count(full, "\"name\": \"Tick\""));
+  EXPECT_EQ(1, Count(full, "displayTimeUnit"));
+  boost::filesystem::remove(trace);
+}
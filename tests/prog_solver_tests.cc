@@ -0,0 +1,271 @@
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include "OsiSolverInterface.hpp"
+
+#include "cyc_limits.h"
+#include "exchange_graph.h"
+#include "prog_solver.h"
+#include "prog_translator.h"
+#include "solver_factory.h"
+
+namespace cyclus {
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// an exclusive request for qty, bid on by two suppliers with the given
+// capacities and preferences
+class ExclusiveRequest {
+ public:
+  ExclusiveRequest(double qty, double cap_v, double pref_v, double cap_w,
+                   double pref_w) {
+    u.reset(new ExchangeNode(qty, true));
+    v.reset(new ExchangeNode());
+    w.reset(new ExchangeNode());
+    av = Arc(u, v);
+    aw = Arc(u, w);
+    av.pref(pref_v);
+    aw.pref(pref_w);
+    u->prefs[av] = pref_v;
+    u->prefs[aw] = pref_w;
+    u->unit_capacities[av].push_back(1);
+    u->unit_capacities[aw].push_back(1);
+    v->unit_capacities[av].push_back(1);
+    w->unit_capacities[aw].push_back(1);
+
+    RequestGroup::Ptr r(new RequestGroup(qty));
+    r->AddCapacity(qty);
+    r->AddExchangeNode(u);
+    g.AddRequestGroup(r);
+    ExchangeNodeGroup::Ptr sv(new ExchangeNodeGroup());
+    sv->AddCapacity(cap_v);
+    sv->AddExchangeNode(v);
+    g.AddSupplyGroup(sv);
+    ExchangeNodeGroup::Ptr sw(new ExchangeNodeGroup());
+    sw->AddCapacity(cap_w);
+    sw->AddExchangeNode(w);
+    g.AddSupplyGroup(sw);
+    g.AddArc(av);
+    g.AddArc(aw);
+  }
+
+  ExchangeGraph g;
+  ExchangeNode::Ptr u, v, w;
+  Arc av, aw;
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ProgSolverTests, IntegralRelaxation) {
+  // the preferred supplier can serve the whole request, so the relaxation is
+  // already integral and Cbc is not needed
+  ExclusiveRequest c(6, 10, 2, 10, 1);
+  ProgSolver s("cbc", true);
+  s.relax_and_round(true);
+  s.Solve(&c.g);
+  EXPECT_TRUE(s.relaxed());
+  ASSERT_EQ(1, c.g.matches().size());
+  EXPECT_EQ(c.av, c.g.matches()[0].first);
+  EXPECT_DOUBLE_EQ(6, c.g.matches()[0].second);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ProgSolverTests, FractionalRelaxation) {
+  // the preferred supplier can only serve 4 of 6, so the relaxation splits the
+  // request 2/3 to 1/3 and Cbc has to settle it on the other supplier
+  ExclusiveRequest c(6, 4, 2, 10, 1);
+  ProgSolver s("cbc", true);
+  s.relax_and_round(true);
+  s.Solve(&c.g);
+  EXPECT_FALSE(s.relaxed());
+  ASSERT_EQ(1, c.g.matches().size());
+  EXPECT_EQ(c.aw, c.g.matches()[0].first);
+  EXPECT_DOUBLE_EQ(6, c.g.matches()[0].second);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ProgSolverTests, RelaxationsReuseInterface) {
+  // the solver keeps its interface across solves, so the bounds fixed by one
+  // relaxation must not carry over to the next program
+  ProgSolver s("cbc", true);
+  s.relax_and_round(true);
+
+  ExclusiveRequest frac(6, 4, 2, 10, 1);
+  s.Solve(&frac.g);
+  EXPECT_FALSE(s.relaxed());
+  ASSERT_EQ(1, frac.g.matches().size());
+  EXPECT_EQ(frac.aw, frac.g.matches()[0].first);
+
+  ExclusiveRequest integral(6, 10, 2, 10, 1);
+  s.Solve(&integral.g);
+  EXPECT_TRUE(s.relaxed());
+  ASSERT_EQ(1, integral.g.matches().size());
+  EXPECT_EQ(integral.av, integral.g.matches()[0].first);
+  EXPECT_DOUBLE_EQ(6, integral.g.matches()[0].second);
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ProgSolverTests, RoundedStart) {
+  ExclusiveRequest c(6, 4, 2, 10, 1);
+  SolverFactory sf("clp");
+  OsiSolverInterface* iface = sf.get();
+  ProgTranslator xlator(&c.g, iface, true);
+  xlator.ToProg();
+  const ProgTranslatorContext& ctx = xlator.ctx();
+
+  // the relaxed solution splits the exclusive request; rounding the larger
+  // share up would exceed the first supplier's capacity, and rounding both up
+  // would violate the exclusive row
+  double relaxed[] = {2.0 / 3, 1.0 / 3};
+  std::vector<int> frac;
+  frac.push_back(0);
+  frac.push_back(1);
+  std::vector<double> flows = RoundedFlows(ctx, 2, relaxed, frac);
+  ASSERT_EQ(2, flows.size());
+  EXPECT_DOUBLE_EQ(0, flows[0]);
+  EXPECT_DOUBLE_EQ(1, flows[1]);
+
+  // the completed start satisfies every row, with the faux arc covering
+  // nothing since the request is met
+  std::vector<double> start = CompleteStart(ctx, flows);
+  ASSERT_EQ(ctx.m.getNumCols(), start.size());
+  EXPECT_DOUBLE_EQ(0, start[2]);
+  std::vector<double> activity(ctx.row_lbs.size(), 0);
+  const CoinBigIndex* starts = ctx.m.getVectorStarts();
+  const int* lens = ctx.m.getVectorLengths();
+  const int* idx = ctx.m.getIndices();
+  const double* vals = ctx.m.getElements();
+  for (int col = 0; col != start.size(); col++) {
+    for (CoinBigIndex k = starts[col]; k != starts[col] + lens[col]; k++) {
+      activity[idx[k]] += vals[k] * start[col];
+    }
+  }
+  for (int r = 0; r != activity.size(); r++) {
+    EXPECT_FALSE(IsNegative(activity[r] - ctx.row_lbs[r])) << "row " << r;
+    EXPECT_FALSE(IsNegative(ctx.row_ubs[r] - activity[r])) << "row " << r;
+  }
+  delete iface;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ProgSolverTests, ConditionedLinearProgram) {
+  // two requests for one supplier, the second more preferred; linear
+  // programs are not solved greedily, but are still conditioned
+  ExchangeGraph g;
+  ExchangeNode::Ptr v(new ExchangeNode());
+  ExchangeNodeGroup::Ptr s(new ExchangeNodeGroup());
+  s->AddCapacity(10);
+  s->AddExchangeNode(v);
+  std::vector<RequestGroup::Ptr> rs;
+  for (int i = 0; i != 2; i++) {
+    ExchangeNode::Ptr u(new ExchangeNode(5, false));
+    Arc a(u, v);
+    a.pref(1 + i);
+    u->prefs[a] = 1 + i;
+    u->unit_capacities[a].push_back(1);
+    v->unit_capacities[a].push_back(1);
+    RequestGroup::Ptr r(new RequestGroup(5));
+    r->AddCapacity(5);
+    r->AddExchangeNode(u);
+    g.AddRequestGroup(r);
+    g.AddArc(a);
+    rs.push_back(r);
+  }
+  g.AddSupplyGroup(s);
+
+  ProgSolver solver("clp", false);
+  solver.Solve(&g);
+  ASSERT_EQ(2, g.request_groups().size());
+  EXPECT_EQ(rs[1], g.request_groups()[0]);
+  EXPECT_EQ(rs[0], g.request_groups()[1]);
+  EXPECT_EQ(2, g.matches().size());
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a request of agent 1 for qty, bid on by agents 2 to nbidders + 1 with a
+// capacity of cap each
+void BuildSplitRequest(ExchangeGraph* g, double qty, int nbidders,
+                       double cap) {
+  ExchangeNode::Ptr u(new ExchangeNode(qty, false, "commod", 1));
+  RequestGroup::Ptr r(new RequestGroup(qty));
+  r->AddCapacity(qty);
+  r->AddExchangeNode(u);
+  g->AddRequestGroup(r);
+  for (int i = 0; i != nbidders; i++) {
+    ExchangeNode::Ptr v(new ExchangeNode(cap, false, "commod", 2 + i));
+    Arc a(u, v);
+    a.pref(1 + i);
+    u->prefs[a] = 1 + i;
+    u->unit_capacities[a].push_back(1);
+    v->unit_capacities[a].push_back(1);
+    ExchangeNodeGroup::Ptr s(new ExchangeNodeGroup());
+    s->AddCapacity(cap);
+    s->AddExchangeNode(v);
+    g->AddSupplyGroup(s);
+    g->AddArc(a);
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ProgSolverTests, WarmStart) {
+  ProgSolver s("clp", false);
+  s.warm_start(true);
+
+  // the first solve has nothing to start from
+  ExchangeGraph g1;
+  BuildSplitRequest(&g1, 5, 2, 3);
+  double obj1 = s.Solve(&g1);
+  EXPECT_FALSE(s.warm_started());
+
+  // the same exchange again starts from the previous basis and gives the
+  // same result
+  ExchangeGraph g2;
+  BuildSplitRequest(&g2, 5, 2, 3);
+  double obj2 = s.Solve(&g2);
+  EXPECT_TRUE(s.warm_started());
+  EXPECT_DOUBLE_EQ(obj1, obj2);
+  ASSERT_EQ(g1.matches().size(), g2.matches().size());
+  for (int i = 0; i != g1.matches().size(); i++) {
+    EXPECT_DOUBLE_EQ(g1.matches()[i].second, g2.matches()[i].second);
+  }
+
+  // a new bidder changes the program's shape, so the basis is not reused,
+  // but the result is still optimal: the most preferred bidder is full
+  ExchangeGraph g3;
+  BuildSplitRequest(&g3, 5, 3, 3);
+  s.Solve(&g3);
+  EXPECT_FALSE(s.warm_started());
+  double total = 0;
+  for (int i = 0; i != g3.matches().size(); i++) {
+    total += g3.matches()[i].second;
+    if (g3.matches()[i].first.vnode()->agent_id == 4) {
+      EXPECT_DOUBLE_EQ(3, g3.matches()[i].second);
+    }
+  }
+  EXPECT_DOUBLE_EQ(5, total);
+
+  // clones share the warm start state
+  ExchangeGraph g4;
+  BuildSplitRequest(&g4, 5, 3, 3);
+  ExchangeSolver* clone = s.Clone();
+  clone->Solve(&g4);
+  EXPECT_TRUE(dynamic_cast<ProgSolver*>(clone)->warm_started());
+  delete clone;
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ProgSolverTests, WarmStartMip) {
+  // the second solve offers the previous solution to Cbc as its incumbent,
+  // which must not change the (exclusive) result
+  ProgSolver s("cbc", true);
+  s.warm_start(true);
+  for (int i = 0; i != 2; i++) {
+    ExclusiveRequest c(6, 4, 2, 10, 1);
+    s.Solve(&c.g);
+    EXPECT_FALSE(s.relaxed());
+    ASSERT_EQ(1, c.g.matches().size()) << "solve " << i;
+    EXPECT_EQ(c.aw, c.g.matches()[0].first) << "solve " << i;
+    EXPECT_DOUBLE_EQ(6, c.g.matches()[0].second) << "solve " << i;
+  }
+}
+
+}  // namespace cyclus
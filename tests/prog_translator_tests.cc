@@ -212,6 +212,9 @@ TEST(ProgTranslatorTests, translation) {
   double row_val_7[] = {1, 1};
   m.appendRow(2, row_ind_7, row_val_7);
 
+  // the translator builds the matrix column by column
+  m.reverseOrdering();
+  EXPECT_TRUE(pt.ctx().m.isColOrdered());
   EXPECT_TRUE(m.isEquivalent2(pt.ctx().m));
 
   // test population
@@ -280,5 +283,67 @@ TEST(ProgTranslatorTests, translation) {
   delete iface;
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(ProgTranslatorTests, ColumnOrderedMatrix) {
+  // a request group with an arc and one without any, which gets neither rows
+  // nor a faux arc
+  ExchangeNode::Ptr u(new ExchangeNode(5, false));
+  ExchangeNode::Ptr w(new ExchangeNode(3, false));
+  ExchangeNode::Ptr v(new ExchangeNode());
+  Arc a(u, v);
+  a.pref(1);
+  u->prefs[a] = 1;
+  u->unit_capacities[a].push_back(0.5);
+  v->unit_capacities[a].push_back(2);
+  v->unit_capacities[a].push_back(3);
+
+  RequestGroup::Ptr r1(new RequestGroup(5));
+  r1->AddCapacity(5);
+  r1->AddExchangeNode(u);
+  RequestGroup::Ptr r2(new RequestGroup(3));
+  r2->AddCapacity(3);
+  r2->AddExchangeNode(w);
+  ExchangeNodeGroup::Ptr s(new ExchangeNodeGroup());
+  s->AddCapacity(10);
+  s->AddCapacity(20);
+  s->AddExchangeNode(v);
+
+  ExchangeGraph g;
+  g.AddRequestGroup(r1);
+  g.AddRequestGroup(r2);
+  g.AddSupplyGroup(s);
+  g.AddArc(a);
+
+  SolverFactory sf("clp");
+  OsiSolverInterface* iface = sf.get();
+  ProgTranslator pt(&g, iface, false, 10);
+  pt.ToProg();
+
+  // supply rows 0 and 1, request row 2; the arc is column 0 and r1's faux arc
+  // column 1
+  const CoinPackedMatrix& m = pt.ctx().m;
+  EXPECT_TRUE(m.isColOrdered());
+  ASSERT_EQ(2, m.getNumCols());
+  ASSERT_EQ(3, m.getNumRows());
+  ASSERT_EQ(4, m.getNumElements());
+  const CoinBigIndex* starts = m.getVectorStarts();
+  const int* lens = m.getVectorLengths();
+  const int* idx = m.getIndices();
+  const double* vals = m.getElements();
+  ASSERT_EQ(3, lens[0]);
+  ASSERT_EQ(1, lens[1]);
+  int rows[] = {0, 1, 2};
+  double coeffs[] = {2, 3, 0.5};
+  for (int k = 0; k != 3; k++) {
+    EXPECT_EQ(rows[k], idx[starts[0] + k]);
+    EXPECT_DOUBLE_EQ(coeffs[k], vals[starts[0] + k]);
+  }
+  EXPECT_EQ(2, idx[starts[1]]);
+  EXPECT_DOUBLE_EQ(1, vals[starts[1]]);
+
+  EXPECT_EQ(2, iface->getNumCols());
+  EXPECT_EQ(3, iface->getNumRows());
+  delete iface;
+}
 
 }  // namespace cyclus
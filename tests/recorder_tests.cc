@@ -141,6 +141,43 @@ TEST(RecorderTest, Manager_Buffering) {
   EXPECT_EQ(back1.notify_count, 1);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(RecorderTest, Manager_PhaseBuffering) {
+  using cyclus::ParallelIdPhase;
+  using cyclus::Recorder;
+  TestBack back1;
+
+  Recorder m;
+  m.set_dump_count(3);
+  m.RegisterBackend(&back1);
+
+  m.NewDatum("Before")->Record();
+  {
+    // slots record into their own buffers, in any order
+    ParallelIdPhase phase(2);
+    ParallelIdPhase::EnterSlot(1);
+    m.NewDatum("Slot1")->Record();
+    ParallelIdPhase::LeaveSlot();
+    ParallelIdPhase::EnterSlot(0);
+    m.NewDatum("Slot0a")->Record();
+    m.NewDatum("Slot0b")->Record();
+    ParallelIdPhase::LeaveSlot();
+    EXPECT_EQ(back1.notify_count, 0);
+  }
+
+  // merged in slot order when the phase ends
+  ASSERT_EQ(back1.notify_count, 1);
+  ASSERT_EQ(back1.flush_count, 3);
+  EXPECT_EQ(back1.data[0]->title(), "Before");
+  EXPECT_EQ(back1.data[1]->title(), "Slot0a");
+  EXPECT_EQ(back1.data[2]->title(), "Slot0b");
+
+  m.Close();
+  ASSERT_EQ(back1.notify_count, 2);
+  ASSERT_EQ(back1.flush_count, 1);
+  EXPECT_EQ(back1.data[0]->title(), "Slot1");
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 TEST(RecorderTest, Manager_CloseFlushing) {
   using cyclus::Recorder;
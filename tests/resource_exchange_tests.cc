@@ -17,6 +17,8 @@
 #include "resource_exchange.h"
 #include "resource_helpers.h"
 #include "test_context.h"
+#include "trader.h"
+#include "trader_management.h"
 #include "test_agents/test_facility.h"
 
 using cyclus::Bid;
@@ -81,6 +83,44 @@ class Requester: public TestFacility {
   int req_ctr_;
 };
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a requester that may be queried concurrently
+class ConcurrentRequester: public Requester {
+ public:
+  ConcurrentRequester(Context* ctx) : Requester(ctx) {}
+
+  virtual cyclus::Agent* Clone() {
+    ConcurrentRequester* m = new ConcurrentRequester(context());
+    m->InitFrom(this);
+    m->port_ = port_;
+    return m;
+  }
+
+  virtual bool IsShim() { return false; }
+};
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a requester that keeps the default preference adjustment
+class DefaultRequester: public TestFacility {
+ public:
+  DefaultRequester(Context* ctx) : TestFacility(ctx) {}
+
+  virtual cyclus::Agent* Clone() {
+    DefaultRequester* m = new DefaultRequester(context());
+    m->InitFrom(this);
+    m->port_ = port_;
+    return m;
+  }
+
+  set<RequestPortfolio<Material>::Ptr> GetMatlRequests() {
+    set<RequestPortfolio<Material>::Ptr> rps;
+    rps.insert(port_);
+    return rps;
+  }
+
+  RequestPortfolio<Material>::Ptr port_;
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class Bidder: public TestFacility {
  public:
@@ -109,6 +149,32 @@ class Bidder: public TestFacility {
   int bid_ctr_;
 };
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+// a policy-like trader that shares its manager with other traders
+class SharedTrader: public cyclus::Trader {
+ public:
+  SharedTrader(Agent* manager, int* in_flight, int* overlaps)
+      : cyclus::Trader(manager),
+        in_flight_(in_flight),
+        overlaps_(overlaps) {}
+
+  void Call() {
+    int n;
+#pragma omp atomic capture
+    n = ++(*in_flight_);
+    if (n > 1) {
+#pragma omp atomic
+      ++(*overlaps_);
+    }
+    for (volatile int i = 0; i < 100000; ++i) {}
+#pragma omp atomic
+    --(*in_flight_);
+  }
+
+  int* in_flight_;
+  int* overlaps_;
+};
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 class ResourceExchangeTests: public ::testing::Test {
  protected:
@@ -309,8 +375,7 @@ TEST_F(ResourceExchangeTests, PrefValues) {
   cobs[creq].insert(std::make_pair(cbid, creq->preference()));
 
   ExchangeContext<Material>& context = exchng->ex_ctx();
-  EXPECT_EQ(context.trader_prefs[parent], pobs);
-  EXPECT_EQ(context.trader_prefs[child], cobs);
+  EXPECT_TRUE(context.trader_prefs.empty());
 
   EXPECT_NO_THROW(exchng->AdjustAll());
 
@@ -318,7 +383,155 @@ TEST_F(ResourceExchangeTests, PrefValues) {
   cobs[creq].begin()->second = std::pow(std::pow(creq->preference(), 2), 2);
   EXPECT_EQ(context.trader_prefs[parent], pobs);
   EXPECT_EQ(context.trader_prefs[child], cobs);
+  EXPECT_EQ(pobs[preq][pbid], context.Pref(pbid));
+  EXPECT_EQ(cobs[creq][cbid], context.Pref(cbid));
+
+  child->Decommission();
+  parent->Decommission();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ResourceExchangeTests, DefaultPrefsSkipped) {
+  // once a requester type is seen to keep the default adjustment, its
+  // preferences are no longer built, unless a parent may adjust them
+  Facility* parent = dynamic_cast<Facility*>(reqr->Clone());
+  parent->Build(NULL);
+  dynamic_cast<Requester*>(parent)->port_ =
+      RequestPortfolio<Material>::Ptr(new RequestPortfolio<Material>());
+  Facility* child = new DefaultRequester(tc.get());
+  child->Build(parent);
+  Facility* plain = new DefaultRequester(tc.get());
+  plain->Build(NULL);
+
+  RequestPortfolio<Material>::Ptr rp1(new RequestPortfolio<Material>());
+  Request<Material>* creq = rp1->AddRequest(mat, child, commod, pref);
+  dynamic_cast<DefaultRequester*>(child)->port_ = rp1;
+  RequestPortfolio<Material>::Ptr rp2(new RequestPortfolio<Material>());
+  Request<Material>* preq = rp2->AddRequest(mat, plain, commod, pref);
+  dynamic_cast<DefaultRequester*>(plain)->port_ = rp2;
+
+  Bidder* bidr = new Bidder(tc.get(), commod);
+  BidPortfolio<Material>::Ptr bp(new BidPortfolio<Material>());
+  Bid<Material>* cbid = bp->AddBid(creq, mat, bidr);
+  Bid<Material>* pbid = bp->AddBid(preq, mat, bidr);
+  bidr->port_ = bp;
+  Facility* bclone = dynamic_cast<Facility*>(bidr->Clone());
+  bclone->Build(NULL);
+
+  for (int i = 0; i < 2; ++i) {
+    ResourceExchange<Material> exchng(tc.get());
+    exchng.AddAllRequests();
+    exchng.AddAllBids();
+    exchng.AdjustAll();
+    ExchangeContext<Material>& context = exchng.ex_ctx();
+    EXPECT_EQ(1 - i, context.trader_prefs.count(plain));
+    EXPECT_EQ(1, context.trader_prefs.count(child));
+    EXPECT_EQ(pref, context.Pref(pbid));
+    EXPECT_EQ(std::pow(pref, 2), context.Pref(cbid));
+  }
 
   child->Decommission();
+  plain->Decommission();
+  parent->Decommission();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ResourceExchangeTests, RequestOrder) {
+  // alternate concurrent and serial requesters, portfolios must be collected
+  // in the order of their requesters' ids regardless
+  std::vector<Facility*> clones;
+  std::vector<RequestPortfolio<Material>::Ptr> ports;
+  for (int i = 0; i < 6; ++i) {
+    Requester* proto = i % 2 == 0 ? new ConcurrentRequester(tc.get())
+                                  : new Requester(tc.get());
+    Facility* clone = dynamic_cast<Facility*>(proto->Clone());
+    clone->Build(NULL);
+    RequestPortfolio<Material>::Ptr rp(new RequestPortfolio<Material>());
+    rp->AddRequest(mat, dynamic_cast<Requester*>(clone), commod, pref);
+    dynamic_cast<Requester*>(clone)->port_ = rp;
+    clones.push_back(clone);
+    ports.push_back(rp);
+  }
+
+  exchng->AddAllRequests();
+  ExchangeContext<Material>& ctx = exchng->ex_ctx();
+  ASSERT_EQ(ports.size(), ctx.requests.size());
+  for (int i = 0; i < ports.size(); ++i) {
+    EXPECT_EQ(ports[i], ctx.requests[i]);
+    EXPECT_EQ(1, dynamic_cast<Requester*>(clones[i])->req_ctr_);
+  }
+
+  exchng->AdjustAll();
+  for (int i = 0; i < clones.size(); ++i) {
+    EXPECT_EQ(1, dynamic_cast<Requester*>(clones[i])->pref_ctr_);
+    clones[i]->Decommission();
+  }
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ResourceExchangeTests, SharedManagerSerial) {
+  // traders of one concurrent manager must never be called at the same time
+  Requester* proto = new ConcurrentRequester(tc.get());
+  Facility* manager = dynamic_cast<Facility*>(proto->Clone());
+  manager->Build(NULL);
+
+  int in_flight = 0;
+  int overlaps = 0;
+  std::vector<SharedTrader> policies(8, SharedTrader(manager, &in_flight,
+                                                     &overlaps));
+  std::vector<cyclus::Trader*> traders;
+  for (int i = 0; i < policies.size(); ++i) {
+    traders.push_back(&policies[i]);
+  }
+
+  std::vector<int> order;
+  cyclus::ForEachTrader(traders, false, [&](int i) {
+    policies[i].Call();
+    order.push_back(i);
+  });
+  EXPECT_EQ(0, overlaps);
+  ASSERT_EQ(traders.size(), order.size());
+  for (int i = 0; i < order.size(); ++i) {
+    EXPECT_EQ(i, order[i]);
+  }
+  manager->Decommission();
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ResourceExchangeTests, SharedParentSerial) {
+  // with parents, traders of different managers below one concurrent parent
+  // share that parent and must never be called at the same time
+  Requester* proto = new ConcurrentRequester(tc.get());
+  Facility* parent = dynamic_cast<Facility*>(proto->Clone());
+  parent->Build(NULL);
+  std::vector<Facility*> managers;
+  std::vector<SharedTrader> policies;
+  for (int i = 0; i < 8; ++i) {
+    managers.push_back(dynamic_cast<Facility*>(proto->Clone()));
+    managers.back()->Build(parent);
+  }
+  int in_flight = 0;
+  int overlaps = 0;
+  for (int i = 0; i < managers.size(); ++i) {
+    policies.push_back(SharedTrader(managers[i], &in_flight, &overlaps));
+  }
+  std::vector<cyclus::Trader*> traders;
+  for (int i = 0; i < policies.size(); ++i) {
+    traders.push_back(&policies[i]);
+  }
+
+  std::vector<int> order;
+  cyclus::ForEachTrader(traders, true, [&](int i) {
+    policies[i].Call();
+    order.push_back(i);
+  });
+  EXPECT_EQ(0, overlaps);
+  ASSERT_EQ(traders.size(), order.size());
+  for (int i = 0; i < order.size(); ++i) {
+    EXPECT_EQ(i, order[i]);
+  }
+  for (int i = 0; i < managers.size(); ++i) {
+    managers[i]->Decommission();
+  }
   parent->Decommission();
 }
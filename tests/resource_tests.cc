@@ -185,3 +185,31 @@ TEST_F(ResourceTest, RepackageLimit) {
   EXPECT_THROW(mmax->Package<Material>(pkg), cyclus::ValueError);
   EXPECT_THROW(pmax->Package<Product>(pkg), cyclus::ValueError);
 }
+
+TEST_F(ResourceTest, ResCast) {
+  Resource::Ptr r = m1;
+  EXPECT_EQ(m1, cyclus::ResCast<Material>(r));
+  EXPECT_EQ(Product::Ptr(), cyclus::ResCast<Product>(r));
+  EXPECT_EQ(Material::Ptr(), cyclus::ResCast<Material>(Resource::Ptr()));
+
+  std::vector<Resource::Ptr> rs;
+  rs.push_back(m1);
+  rs.push_back(p1);
+  std::vector<Product::Ptr> ps = cyclus::ResCast<Product>(rs);
+  ASSERT_EQ(2, ps.size());
+  EXPECT_EQ(Product::Ptr(), ps[0]);
+  EXPECT_EQ(p1, ps[1]);
+}
+
+TEST_F(ResourceTest, PooledMaterials) {
+  // pooled materials (and their control blocks) are released and reused
+  // across many short lived extract/absorb cycles
+  for (int i = 0; i < 1000; ++i) {
+    Material::Ptr m = m2->ExtractQty(1);
+    Resource::Ptr clone = m->Clone();
+    m2->Absorb(m);
+    EXPECT_DOUBLE_EQ(1, clone->quantity());
+  }
+  EXPECT_DOUBLE_EQ(7, m2->quantity());
+  EXPECT_EQ(1, m1.use_count());
+}
@@ -158,15 +158,15 @@ class SimInitTest : public ::testing::TestWithParam<int> {
 
   void resetnextids() {
     Agent::next_id_ = 0;
-    cy::Resource::nextstate_id_ = 1;
-    cy::Resource::nextobj_id_ = 1;
-    cy::Composition::next_id_ = 1;
+    cy::Resource::nextstate_id_.Reset(1);
+    cy::Resource::nextobj_id_.Reset(1);
+    cy::Composition::next_id_.Reset(1);
     cy::Product::next_qualid_ = 1;
   }
   int agentid() { return Agent::next_id_; }
-  int stateid() { return cy::Resource::nextstate_id_; }
-  int objid() { return cy::Resource::nextobj_id_; }
-  int compid() { return cy::Composition::next_id_; }
+  int stateid() { return cy::Resource::nextstate_id_.next(); }
+  int objid() { return cy::Resource::nextobj_id_.next(); }
+  int compid() { return cy::Composition::next_id_.next(); }
   int prodid() { return cy::Product::next_qualid_; }
   int transid(cy::Context* ctx) { return ctx->trans_id_; }
 
@@ -174,8 +174,8 @@ class SimInitTest : public ::testing::TestWithParam<int> {
   std::set<Agent*> agent_list(cy::Context* ctx) { return ctx->agent_list_; }
   std::map<int, cy::TimeListener*> tickers(cy::Timer* ti) { return ti->tickers_; }
 
-  std::map<int, std::vector<std::pair<std::string, Agent*> > >
-  build_queue(cy::Timer* ti) {
+  std::map<int, std::vector<cy::Timer::BuildOrder> > build_queue(
+      cy::Timer* ti) {
     return ti->build_queue_;
   }
   std::map<int, std::vector<Agent*> > decom_queue(cy::Timer* ti) {
@@ -264,20 +264,21 @@ TEST_P(SimInitTest, InitTimeListeners) {
 TEST_P(SimInitTest, InitBuildSched) {
   cy::SimInit si;
   si.Init(&rec, b);
-  std::map<int, std::vector<std::pair<std::string, Agent*> > > queue = build_queue(si.timer());
+  auto queue = build_queue(si.timer());
 
   EXPECT_EQ(2, queue.size());
 
   int n_sched_t2 = queue[2].size();
   EXPECT_EQ(1, n_sched_t2);
   if (n_sched_t2 == 1) {
-    EXPECT_EQ("proto1", queue[2][0].first);
+    EXPECT_EQ("proto1", queue[2][0].proto);
+    EXPECT_EQ(1, queue[2][0].n);
   }
 
   int n_sched_t3 = queue[3].size();
   EXPECT_EQ(1, n_sched_t3);
   if (n_sched_t3 == 1) {
-    EXPECT_EQ("proto2", queue[3][0].first);
+    EXPECT_EQ("proto2", queue[3][0].proto);
   }
 }
 
@@ -452,6 +453,71 @@ TEST_P(SimInitTest, RestartSimInfo) {
   EXPECT_EQ(2, info.branch_time);
 }
 
+TEST(SimInitCompositionTests, CompactDecayChains) {
+  cy::Timer ti;
+  cy::Recorder rec;
+  cy::SqliteBack back(dbpath);
+  rec.RegisterBackend(&back);
+  cy::Context ctx(&ti, &rec);
+  cy::SimInfo si(5);
+  si.compact_decay_chains = true;
+  ctx.InitSim(si);
+
+  cy::CompMap v;
+  v[551370000] = 1;
+  v[922380000] = 10;
+  cy::Composition::Ptr c = cy::Composition::CreateFromAtom(v);
+  uint64_t dt = si.dt;
+  cy::Composition::Ptr dec1 = c->Decay(12, dt, true);
+  cy::Composition::Ptr dec2 = dec1->Decay(24, dt, true);
+  dec2->Record(&ctx);
+  rec.Flush();
+
+  // only the undecayed root is recorded in full
+  std::vector<cy::Cond> conds;
+  conds.push_back(cy::Cond("QualId", "==", dec2->id()));
+  EXPECT_EQ(0, back.Query("Compositions", &conds).rows.size());
+  cy::QueryResult qr = back.Query("DecayedCompositions", &conds);
+  ASSERT_EQ(1, qr.rows.size());
+  EXPECT_EQ(dec1->id(), qr.GetVal<int>("ParentQualId"));
+  EXPECT_EQ(24, qr.GetVal<int>("DecayTime"));
+  conds[0] = cy::Cond("QualId", "==", c->id());
+  EXPECT_EQ(2, back.Query("Compositions", &conds).rows.size());
+
+  // the decayed composition is materialized on demand
+  cy::Composition::Ptr loaded = cy::SimInit::BuildComposition(&back,
+                                                              dec2->id());
+  EXPECT_EQ(dec2->id(), loaded->id());
+  cy::CompMap expect = dec2->mass();
+  cy::CompMap got = loaded->mass();
+  cy::compmath::Normalize(&expect);
+  cy::compmath::Normalize(&got);
+  EXPECT_TRUE(cy::compmath::AlmostEq(expect, got, 1e-10));
+
+  // decays do not keep their parents alive, and without one the decayed
+  // composition is recorded in full
+  cy::Composition::Ptr root = cy::Composition::CreateFromAtom(v);
+  cy::Composition::Ptr orphan = root->Decay(12, dt, true);
+  boost::weak_ptr<cy::Composition> gone = root;
+  root.reset();
+  EXPECT_TRUE(gone.expired());
+  orphan->Record(&ctx);
+
+  // unlinked decays are recorded in full as well
+  cy::Composition::Ptr unlinked = c->Decay(6, dt);
+  unlinked->Record(&ctx);
+  rec.Flush();
+  conds[0] = cy::Cond("QualId", "==", orphan->id());
+  EXPECT_EQ(0, back.Query("DecayedCompositions", &conds).rows.size());
+  EXPECT_EQ(orphan->mass().size(),
+            back.Query("Compositions", &conds).rows.size());
+  conds[0] = cy::Cond("QualId", "==", unlinked->id());
+  EXPECT_EQ(0, back.Query("DecayedCompositions", &conds).rows.size());
+  EXPECT_EQ(unlinked->mass().size(),
+            back.Query("Compositions", &conds).rows.size());
+  rec.Close();
+}
+
 #if CYCLUS_IS_PARALLEL
 INSTANTIATE_TEST_CASE_P(SimInitTests, SimInitTest, ::testing::Values(1, 2, 3, 4));
 #else
@@ -3,6 +3,7 @@
 #include "CoinMessageHandler.hpp"
 #include "CoinPackedMatrix.hpp"
 #include "CoinPackedVector.hpp"
+#include "CoinWarmStart.hpp"
 #include "OsiSolverInterface.hpp"
 
 #include "equality_helpers.h"
@@ -126,6 +127,34 @@ TEST_F(SolverFactoryTests, ClpRedundant) {
   delete si;
 }
 
+TEST_F(SolverFactoryTests, ClpWarmStart) {
+  sf_.solver_t("clp");
+  OsiSolverInterface* si = sf_.get();
+  CoinMessageHandler h;
+  h.setLogLevel(0);
+  si->passInMessageHandler(&h);
+  Init(si);
+  SolveProg(si);
+  CoinWarmStart* basis = si->getWarmStart();
+
+  // the same program is resolved from its basis
+  Init(si);
+  EXPECT_TRUE(BasisFits(basis, si));
+  EXPECT_TRUE(SolveProg(si, si->getInfinity(), false, NULL, basis));
+  array_double_eq(lp_exp_, si->getColSolution(), n_vars_);
+  EXPECT_DOUBLE_EQ(lp_obj_, si->getObjValue());
+
+  // a program of another shape is solved from scratch
+  InitRedundant(si);
+  EXPECT_FALSE(BasisFits(basis, si));
+  EXPECT_FALSE(SolveProg(si, si->getInfinity(), false, NULL, basis));
+  EXPECT_DOUBLE_EQ(1, si->getObjValue());
+  EXPECT_FALSE(SolveProg(si, si->getInfinity(), false, NULL, NULL));
+  EXPECT_DOUBLE_EQ(1, si->getObjValue());
+  delete basis;
+  delete si;
+}
+
 TEST_F(SolverFactoryTests, Cbc) {
   if (!Env::allow_milps()) {
     std::cout << "[  SKIPPED ] MILPS have been disabled.\n";
@@ -5,6 +5,7 @@
 #include "exchange_graph.h"
 #include "exchange_test_cases.h"
 #include "greedy_solver.h"
+#include "min_cost_flow_solver.h"
 #include "prog_solver.h"
 
 namespace cyclus {
@@ -144,6 +145,16 @@ TYPED_TEST(ExchangeSolverTest, ExclusiveGreedySolver) {
   delete solver;
 }
 
+TYPED_TEST(ExchangeSolverTest, MinCostFlowSolver) {
+  std::string type = "min-cost-flow";
+  ExchangeGraph g;
+  bool exclusive_orders = false;
+  this->case_->Construct(&g, exclusive_orders);
+  MinCostFlowSolver solver(exclusive_orders);
+  double obj = solver.Solve(&g);
+  this->case_->Test(type, &g);
+}
+
 // add any more solvers to test here
 
 #endif  // GTEST_HAS_TYPED_TEST
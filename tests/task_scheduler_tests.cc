@@ -0,0 +1,65 @@
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "error.h"
+#include "task_scheduler.h"
+
+using cyclus::TaskScheduler;
+
+TEST(TaskSchedulerTests, RunsEveryTaskOnce) {
+  TaskScheduler sched;
+  std::vector<int> keys;
+  keys.push_back(7);
+  keys.push_back(3);
+  keys.push_back(11);
+  std::vector<int> runs(keys.size(), 0);
+  int serial = 0;
+  for (int step = 0; step < 3; ++step) {
+    sched.Run(keys, [&runs](int i) {
+#pragma omp atomic
+      runs[i]++;
+    }, [&serial]() { serial++; });
+  }
+
+  for (int i = 0; i < runs.size(); ++i) {
+    EXPECT_EQ(3, runs[i]);
+    EXPECT_GE(sched.cost(keys[i]), 0);
+  }
+  EXPECT_EQ(3, serial);
+  EXPECT_LT(sched.cost(5), 0);
+
+  sched.Reset();
+  EXPECT_LT(sched.cost(7), 0);
+}
+
+TEST(TaskSchedulerTests, SerialTaskRunsFirst) {
+  // the serial task runs before the batch, with or without OpenMP
+  TaskScheduler sched;
+  std::vector<int> keys(8, 0);
+  for (int i = 0; i < keys.size(); ++i) {
+    keys[i] = i;
+  }
+  std::vector<int> seen(keys.size(), -1);
+  int serial = 0;
+  sched.Run(keys, [&seen, &serial](int i) {
+    seen[i] = serial;
+  }, [&serial]() { serial = 1; });
+  EXPECT_EQ(std::vector<int>(keys.size(), 1), seen);
+}
+
+TEST(TaskSchedulerTests, Errors) {
+  EXPECT_THROW(TaskScheduler(0), cyclus::ValueError);
+  EXPECT_THROW(TaskScheduler(1.5), cyclus::ValueError);
+
+  TaskScheduler sched;
+  std::vector<int> keys(4, 0);
+  for (int i = 0; i < keys.size(); ++i) {
+    keys[i] = i;
+  }
+  EXPECT_THROW(sched.Run(keys, [](int i) {
+    if (i == 2) {
+      throw cyclus::StateError("task failed");
+    }
+  }), cyclus::StateError);
+}
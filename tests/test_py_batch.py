@@ -0,0 +1,72 @@
+import os
+import json
+import sqlite3
+import subprocess
+
+
+inputfile = {
+ 'simulation': {
+  'archetypes': {
+   'spec': [
+    {'lib': 'bear_deploy', 'name': 'DemandFac'},
+    {'lib': 'agents', 'name': 'NullRegion'},
+    {'lib': 'bear_deploy', 'name': 'NOInst'},
+   ],
+  },
+  'control': {'duration': 12, 'startmonth': 1, 'startyear': 2000},
+  'facility': {
+   'config': {
+    'DemandFac': {
+     'commodity': 'bears',
+     'production_rate_max': 12,
+     'production_rate_min': 8,
+    },
+   },
+   'lifetime': 4,
+   'name': 'BearStore',
+  },
+  'region': {
+   'config': {'NullRegion': '\n      '},
+   'institution': {
+    'config': {
+     'NOInst': {
+      'growth_commod': 'bears',
+      'growth_rate': 0.1,
+      'initial_demand': 20.0,
+      'prototypes': {'val': 'BearStore'},
+     },
+    },
+    'initialfacilitylist': {'entry': {'number': 2, 'prototype': 'BearStore'}},
+    'name': 'SingleInstitution',
+   },
+   'name': 'SingleRegion',
+  },
+ },
+}
+
+
+def run_exits(args, outfile):
+    if os.path.exists(outfile):
+        os.remove(outfile)
+    env = dict(os.environ)
+    env['PYTHONPATH'] = "."
+    subprocess.check_call(['cyclus', '-o', outfile] + args + ['py_batch.json'],
+                          universal_newlines=True, env=env)
+    conn = sqlite3.connect(outfile)
+    exits = conn.execute('SELECT AgentId, ExitTime FROM AgentExit '
+                         'ORDER BY AgentId').fetchall()
+    conn.close()
+    os.remove(outfile)
+    return exits
+
+
+def test_py_batch_inst_decom():
+    # the Python institution must still decommission its children when all
+    # Python agents are tocked in a batch
+    with open('py_batch.json', 'w') as f:
+        json.dump(inputfile, f)
+    exits = run_exits([], 'py_batch.sqlite')
+    batch_exits = run_exits(['--py-batch'], 'py_batch_on.sqlite')
+    os.remove('py_batch.json')
+    assert len(exits) > 0
+    assert exits == batch_exits
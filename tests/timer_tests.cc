@@ -101,6 +101,83 @@ class SnapperDec : public cyclus::Facility {
   bool snap;
 };
 
+class Napper : public cyclus::Facility {
+ public:
+  Napper(cyclus::Context* ctx)
+      : cyclus::Facility(ctx), phases(cyclus::kAllPhases), dre_idle(true),
+        ticks(0), tocks(0), decisions(0) {}
+  virtual ~Napper() {}
+
+  virtual cyclus::Agent* Clone() { return new Napper(context()); }
+  virtual void InitInv(cyclus::Inventories& inv) {}
+  virtual cyclus::Inventories SnapshotInv() { return cyclus::Inventories(); }
+  virtual int TimePhases() { return phases; }
+
+  // sleeps through time steps 1 and 2
+  void Tick() {
+    ticks++;
+    if (context()->time() == 0) {
+      context()->Sleep(this, 3, false, dre_idle);
+    }
+  }
+  void Tock() { tocks++; }
+  void Decision() { decisions++; }
+
+  int phases;
+  bool dre_idle;
+  int ticks;
+  int tocks;
+  int decisions;
+};
+
+class Waker : public cyclus::Facility {
+ public:
+  Waker(cyclus::Context* ctx) : cyclus::Facility(ctx), napper(NULL) {}
+  virtual ~Waker() {}
+
+  virtual cyclus::Agent* Clone() { return new Waker(context()); }
+  virtual void InitInv(cyclus::Inventories& inv) {}
+  virtual cyclus::Inventories SnapshotInv() { return cyclus::Inventories(); }
+
+  void Tick() {}
+  void Tock() {
+    if (context()->time() == 1) {
+      context()->Wake(napper);
+    }
+  }
+  void Decision() {}
+
+  Napper* napper;
+};
+
+class Holder : public cyclus::Facility {
+ public:
+  Holder(cyclus::Context* ctx) : cyclus::Facility(ctx), snapshots(0) {
+    cyclus::CompMap v;
+    v[922350000] = 1;
+    mat = cyclus::Material::CreateUntracked(
+        1, cyclus::Composition::CreateFromMass(v));
+  }
+  virtual ~Holder() {}
+
+  virtual cyclus::Agent* Clone() { return new Holder(context()); }
+  virtual void InitInv(cyclus::Inventories& inv) {}
+  virtual cyclus::Inventories SnapshotInv() {
+    snapshots++;
+    cyclus::Inventories invs;
+    invs["inv"].push_back(mat);
+    return invs;
+  }
+  virtual int InventoryVersion() { return 0; }
+
+  void Tick() {}
+  void Tock() {}
+  void Decision() {}
+
+  cyclus::Material::Ptr mat;
+  int snapshots;
+};
+
 class TimerTestsFixture : public ::testing::TestWithParam<int> {
   protected:
     #if CYCLUS_IS_PARALLEL
@@ -279,6 +356,232 @@ TEST_P(TimerTestsFixture, DoubleDecom) {
   cyclus::PyStop();
 }
 
+TEST_P(TimerTestsFixture, BulkBuildAndRedecom) {
+  cyclus::PyStart();
+  cyclus::Recorder rec;
+  cyclus::Timer ti;
+  cyclus::Context ctx(&ti, &rec);
+  cyclus::SqliteBack b(path);
+  rec.RegisterBackend(&b);
+
+  ti.Initialize(&ctx, cyclus::SimInfo(4));
+  ctx.AddPrototype("napper", new Napper(&ctx));
+  ctx.SchedBuilds(NULL, "napper", 3, 1);
+  EXPECT_THROW(ctx.SchedBuilds(NULL, "napper", -1, 1), cyclus::ValueError);
+
+  // rescheduling replaces the earlier decommissioning
+  Napper* n = new Napper(&ctx);
+  n->Build(NULL);
+  ctx.SchedDecom(n, 3);
+  ctx.SchedDecom(n, 2);
+
+  ti.RunSim();
+  rec.Close();
+
+  EXPECT_EQ(3, b.Query("BuildSchedule", NULL).rows.size());
+  std::vector<cyclus::Cond> conds;
+  conds.push_back(cyclus::Cond("EnterTime", "==", 1));
+  EXPECT_EQ(3, b.Query("AgentEntry", &conds).rows.size());
+
+  cyclus::QueryResult qr = b.Query("AgentExit", NULL);
+  ASSERT_EQ(1, qr.rows.size());
+  EXPECT_EQ(2, qr.GetVal<int>("ExitTime"));
+  cyclus::PyStop();
+}
+
+TEST_P(TimerTestsFixture, Sleep) {
+  cyclus::PyStart();
+  cyclus::Recorder rec;
+  cyclus::Timer ti;
+  cyclus::Context ctx(&ti, &rec);
+
+  ti.Initialize(&ctx, cyclus::SimInfo(5));
+
+  // sleeping starts right after the Tick of time step 0
+  Napper* n = new Napper(&ctx);
+  n->Build(NULL);
+  ti.RunSim();
+  EXPECT_EQ(3, n->ticks);
+  EXPECT_EQ(2, n->tocks);
+  EXPECT_EQ(2, n->decisions);
+  EXPECT_FALSE(ti.asleep(n));
+  EXPECT_THROW(ctx.Sleep(n, ti.time()), cyclus::ValueError);
+  cyclus::PyStop();
+}
+
+TEST_P(TimerTestsFixture, Wake) {
+  cyclus::PyStart();
+  cyclus::Recorder rec;
+  cyclus::Timer ti;
+  cyclus::Context ctx(&ti, &rec);
+
+  ti.Initialize(&ctx, cyclus::SimInfo(5));
+
+  // woken in the Tock of time step 1, in time for its Decision
+  Napper* n = new Napper(&ctx);
+  n->Build(NULL);
+  Waker* w = new Waker(&ctx);
+  w->napper = n;
+  w->Build(NULL);
+  ti.RunSim();
+  EXPECT_EQ(4, n->ticks);
+  EXPECT_EQ(3, n->tocks);
+  EXPECT_EQ(4, n->decisions);
+  cyclus::PyStop();
+}
+
+TEST_P(TimerTestsFixture, FastForward) {
+  cyclus::PyStart();
+  cyclus::Recorder rec;
+  cyclus::Timer ti;
+  cyclus::Context ctx(&ti, &rec);
+  cyclus::SqliteBack b(path);
+  rec.RegisterBackend(&b);
+
+  cyclus::SimInfo si(5);
+  si.fast_forward = true;
+  ti.Initialize(&ctx, si);
+
+  // time steps 1 and 2 are skipped, without affecting the napper
+  Napper* n = new Napper(&ctx);
+  n->Build(NULL);
+  ti.RunSim();
+  rec.Close();
+  EXPECT_EQ(3, n->ticks);
+  EXPECT_EQ(2, n->tocks);
+  EXPECT_EQ(2, n->decisions);
+
+  cyclus::QueryResult qr = b.Query("FastForward", NULL);
+  ASSERT_EQ(1, qr.rows.size());
+  EXPECT_EQ(1, qr.GetVal<int>("StartTime"));
+  EXPECT_EQ(2, qr.GetVal<int>("EndTime"));
+  cyclus::PyStop();
+}
+
+TEST_P(TimerTestsFixture, FastForwardTradingSleeper) {
+  cyclus::PyStart();
+  cyclus::Recorder rec;
+  cyclus::Timer ti;
+  cyclus::Context ctx(&ti, &rec);
+  cyclus::SqliteBack b(path);
+  rec.RegisterBackend(&b);
+
+  cyclus::SimInfo si(5);
+  si.fast_forward = true;
+  ti.Initialize(&ctx, si);
+
+  // the napper may still trade while asleep, so no time step is skipped
+  Napper* n = new Napper(&ctx);
+  n->dre_idle = false;
+  n->Build(NULL);
+  ti.RunSim();
+  rec.Close();
+  EXPECT_EQ(3, n->ticks);
+
+  EXPECT_EQ(0, b.Tables().count("FastForward"));
+  cyclus::PyStop();
+}
+
+TEST_P(TimerTestsFixture, Profile) {
+  cyclus::PyStart();
+  cyclus::Recorder rec;
+  cyclus::Timer ti;
+  cyclus::Context ctx(&ti, &rec);
+  cyclus::SqliteBack b(path);
+  rec.RegisterBackend(&b);
+
+  ti.Initialize(&ctx, cyclus::SimInfo(5));
+  ctx.profiler()->enabled(true);
+
+  Napper* n = new Napper(&ctx);
+  n->Build(NULL);
+  ti.RunSim();
+  rec.Close();
+
+  std::vector<cyclus::Cond> conds;
+  conds.push_back(cyclus::Cond("Phase", "==", std::string("Tick")));
+  conds.push_back(cyclus::Cond("AgentId", "==", n->id()));
+  cyclus::QueryResult qr = b.Query("Profile", &conds);
+  ASSERT_EQ(1, qr.rows.size());
+  EXPECT_EQ(-1, qr.GetVal<int>("Time"));
+  EXPECT_EQ(3, qr.GetVal<int>("Calls"));
+  EXPECT_GE(qr.GetVal<double>("Duration"), 0);
+
+  // the Tick phase is recorded in every time step
+  conds[1] = cyclus::Cond("AgentId", "==", -1);
+  qr = b.Query("Profile", &conds);
+  EXPECT_EQ(5, qr.rows.size());
+  cyclus::PyStop();
+}
+
+TEST_P(TimerTestsFixture, UnchangedInventory) {
+  cyclus::PyStart();
+  cyclus::Recorder rec;
+  cyclus::Timer ti;
+  cyclus::Context ctx(&ti, &rec);
+  cyclus::SqliteBack b(path);
+  rec.RegisterBackend(&b);
+
+  cyclus::SimInfo si(3);
+  si.explicit_inventory = true;
+  ti.Initialize(&ctx, si);
+
+  // the inventory is recorded every time step, but only snapshotted once for
+  // that and once for the snapshot at the end of the simulation
+  Holder* h = new Holder(&ctx);
+  h->Build(NULL);
+  ti.RunSim();
+  rec.Close();
+  EXPECT_EQ(2, h->snapshots);
+
+  std::vector<cyclus::Cond> conds;
+  conds.push_back(cyclus::Cond("AgentId", "==", h->id()));
+  cyclus::QueryResult qr = b.Query("ExplicitInventory", &conds);
+  ASSERT_EQ(3, qr.rows.size());
+  for (int i = 0; i < qr.rows.size(); ++i) {
+    EXPECT_EQ(i, qr.GetVal<int>("Time", i));
+    EXPECT_EQ(922350000, qr.GetVal<int>("NucId", i));
+    EXPECT_DOUBLE_EQ(1, qr.GetVal<double>("Quantity", i));
+  }
+  cyclus::PyStop();
+}
+
+TEST_P(TimerTestsFixture, BatchDispatch) {
+  cyclus::PyStart();
+  cyclus::Recorder rec;
+  cyclus::Timer ti;
+  cyclus::Context ctx(&ti, &rec);
+  ti.Initialize(&ctx, cyclus::SimInfo(5));
+
+  // listeners that are not Python agents are still called one by one
+  cyclus::PY_BATCH_DISPATCH = true;
+  Napper* n = new Napper(&ctx);
+  n->Build(NULL);
+  ti.RunSim();
+  cyclus::PY_BATCH_DISPATCH = false;
+  EXPECT_EQ(3, n->ticks);
+  EXPECT_EQ(2, n->tocks);
+  cyclus::PyStop();
+}
+
+TEST_P(TimerTestsFixture, TimePhases) {
+  cyclus::PyStart();
+  cyclus::Recorder rec;
+  cyclus::Timer ti;
+  cyclus::Context ctx(&ti, &rec);
+
+  ti.Initialize(&ctx, cyclus::SimInfo(5));
+
+  Napper* n = new Napper(&ctx);
+  n->phases = cyclus::kTickPhase | cyclus::kDecisionPhase;
+  n->Build(NULL);
+  ti.RunSim();
+  EXPECT_EQ(3, n->ticks);
+  EXPECT_EQ(0, n->tocks);
+  EXPECT_EQ(2, n->decisions);
+  cyclus::PyStop();
+}
+
 #if CYCLUS_IS_PARALLEL
 INSTANTIATE_TEST_CASE_P(TimerTestsParallel, TimerTestsFixture, ::testing::Values(1, 2, 3, 4));
 #else
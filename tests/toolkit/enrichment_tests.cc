@@ -98,5 +98,41 @@ TEST_F(EnrichmentTests, enrichmentcalcs) {
   EXPECT_NEAR(swu_, SwuRequired(product_qty, assays), cyclus::CY_NEAR_ZERO);
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(EnrichmentConverterTests, Convert) {
+  double feed = 0.0072;
+  double tails = 0.002;
+  CompMap v;
+  v[922350000] = 0.05;
+  v[922380000] = 0.95;
+  Material::Ptr m =
+      Material::CreateUntracked(10, Composition::CreateFromMass(v));
+  Assays assays(feed, 0.05, tails);
+
+  SWUConverter swu(feed, tails);
+  NatUConverter natu(feed, tails);
+  EXPECT_DOUBLE_EQ(SwuRequired(10, assays), swu.convert(m));
+  EXPECT_DOUBLE_EQ(FeedQty(10, assays), natu.convert(m));
+
+  // conversions are proportional to the offer's quantity
+  Material::Ptr half = m->ExtractQty(5);
+  EXPECT_DOUBLE_EQ(SwuRequired(5, assays), swu.convert(half));
+  EXPECT_DOUBLE_EQ(FeedQty(5, assays), natu.convert(half));
+}
+
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST(EnrichmentConverterTests, Memoizable) {
+  SWUConverter swu(0.0072, 0.002);
+  SWUConverter same(0.0072, 0.002);
+  SWUConverter other(0.0072, 0.003);
+  NatUConverter natu(0.0072, 0.002);
+  EXPECT_TRUE(swu.memoizable());
+  EXPECT_TRUE(natu.memoizable());
+  EXPECT_TRUE(swu == same);
+  EXPECT_FALSE(swu == other);
+  EXPECT_FALSE(swu == natu);
+  EXPECT_FALSE(natu == swu);
+}
+
 }  // namespace toolkit
 }  // namespace cyclus
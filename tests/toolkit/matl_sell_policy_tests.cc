@@ -10,6 +10,7 @@
 #include "error.h"
 #include "pyne.h"
 #include "package.h"
+#include "exchange_translator.h"
 
 #include "test_context.h"
 #include "test_agents/test_facility.h"
@@ -123,6 +124,40 @@ TEST_F(MatlSellPolicyTests, Bids) {
   delete req;
 }
 
+TEST_F(MatlSellPolicyTests, QuantizedBids) {
+  MatlSellPolicy p;
+  std::string commod("commod");
+  CommodMap<Material>::type reqs;
+  Request<Material>* req1 = Request<Material>::Create(mat1, fac1, commod);
+  Request<Material>* req2 = Request<Material>::Create(mat1, fac1, commod);
+  reqs[commod].push_back(req1);
+  reqs[commod].push_back(req2);
+
+  // Qty = 3, Quanta = 1 -> 3 bids on each request, each of which may clear
+  // on its own
+  p.Init(fac1, &buff, "", qty, false, 1).Set(commod);
+  std::set<BidPortfolio<Material>::Ptr> obs = p.GetMatlBids(reqs);
+  ASSERT_EQ(1, obs.size());
+  const std::set<Bid<Material>*>& bids = (*obs.begin())->bids();
+  ASSERT_EQ(6, bids.size());
+
+  std::set<Material::Ptr> offers;
+  std::set<Bid<Material>*>::const_iterator it;
+  for (it = bids.begin(); it != bids.end(); ++it) {
+    EXPECT_TRUE((*it)->exclusive());
+    offers.insert((*it)->offer());
+  }
+  EXPECT_EQ(6, offers.size());
+
+  ExchangeTranslationContext<Material> xlation_ctx;
+  ExchangeNodeGroup::Ptr g =
+      TranslateBidPortfolio<Material>(xlation_ctx, *obs.begin());
+  EXPECT_EQ(6, g->excl_node_groups().size());
+
+  delete req1;
+  delete req2;
+}
+
 TEST_F(MatlSellPolicyTests, Trades) {
   MatlSellPolicy p;
   std::string commod("commod");
@@ -0,0 +1,30 @@
+#include <gtest/gtest.h>
+
+#include "composition.h"
+#include "material.h"
+#include "toolkit/offer_cache.h"
+
+using cyclus::Composition;
+using cyclus::Material;
+using cyclus::toolkit::OfferCache;
+
+TEST(OfferCacheTests, Get) {
+  cyclus::CompMap v;
+  v[922350000] = 1;
+  Composition::Ptr c1 = Composition::CreateFromMass(v);
+  Composition::Ptr c2 = Composition::CreateFromMass(v);
+
+  OfferCache cache;
+  Material::Ptr m = cache.Get(5, c1);
+  EXPECT_DOUBLE_EQ(5, m->quantity());
+  EXPECT_EQ(c1, m->comp());
+
+  EXPECT_EQ(m, cache.Get(5, c1));
+  EXPECT_NE(m, cache.Get(4, c1));
+  EXPECT_NE(m, cache.Get(5, c2));
+  EXPECT_EQ(3, cache.size());
+
+  cache.Clear();
+  EXPECT_EQ(0, cache.size());
+  EXPECT_NE(m, cache.Get(5, c1));
+}
@@ -356,6 +356,26 @@ TEST_F(ProductBufTest, PushAll_DuplicateEmpty) {
   EXPECT_DOUBLE_EQ(store_.quantity(), mat1_->quantity() + mat2_->quantity());
 }
 
+// - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
+TEST_F(ProductBufTest, Version) {
+  int v = filled_store_.version();
+  EXPECT_EQ(v, filled_store_.version());
+
+  // reads leave the buffer unchanged
+  ResVec vals = filled_store_.ResValues();
+  ASSERT_EQ(2, vals.size());
+  EXPECT_EQ(mat1_, vals[0]);
+  EXPECT_EQ(mat2_, vals[1]);
+  EXPECT_EQ(2, filled_store_.count());
+  EXPECT_EQ(v, filled_store_.version());
+
+  Product::Ptr p = filled_store_.Pop();
+  EXPECT_LT(v, filled_store_.version());
+  v = filled_store_.version();
+  filled_store_.Push(p);
+  EXPECT_LT(v, filled_store_.version());
+}
+
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
 // Special tests for material buffers
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
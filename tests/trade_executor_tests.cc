@@ -89,21 +89,22 @@ class TradeExecutorTests : public ::testing::Test {
 TEST_F(TradeExecutorTests, SupplierGrouping) {
   TradeExecutor<Material> exec(trades);
   GroupTradesBySupplier(exec.trade_ctx(), trades);
-  std::map<Trader*, std::vector< Trade<Material> > > obs =
+  std::vector< std::vector< Trade<Material> > > obs =
       exec.trade_ctx().trades_by_supplier;
-  std::map<Trader*, std::vector< Trade<Material> > > exp;
-  exp[s1].push_back(t1);
-  exp[s2].push_back(t2);
-  exp[s2].push_back(t3);
+  std::vector< std::vector< Trade<Material> > > exp(2);
+  exp[0].push_back(t1);
+  exp[1].push_back(t2);
+  exp[1].push_back(t3);
 
   EXPECT_EQ(obs, exp);
 
-  std::set<Trader*> requesters;
-  std::set<Trader*> suppliers;
-  requesters.insert(r1);
-  requesters.insert(r2);
-  suppliers.insert(s1);
-  suppliers.insert(s2);
+  // traders are kept in the order of their first trade
+  std::vector<Trader*> requesters;
+  std::vector<Trader*> suppliers;
+  requesters.push_back(r1);
+  requesters.push_back(r2);
+  suppliers.push_back(s1);
+  suppliers.push_back(s2);
   EXPECT_EQ(exec.trade_ctx().requesters, requesters);
   EXPECT_EQ(exec.trade_ctx().suppliers, suppliers);
 }
@@ -114,37 +115,37 @@ TEST_F(TradeExecutorTests, SupplierResponses) {
   GroupTradesBySupplier(exec.trade_ctx(), trades);
   GetTradeResponses(exec.trade_ctx());
 
-  std::map<Trader*,
-           std::vector< std::pair<Trade<Material>, Material::Ptr> > >
+  std::vector< std::vector< std::pair<Trade<Material>, Material::Ptr> > >
       by_req_obs = exec.trade_ctx().trades_by_requester;
-  EXPECT_NE(std::find(by_req_obs[r1].begin(),
-                      by_req_obs[r1].end(),
+  ASSERT_EQ(2, by_req_obs.size());
+  EXPECT_NE(std::find(by_req_obs[0].begin(),
+                      by_req_obs[0].end(),
                       std::make_pair(t1, fac.mat)),
-            by_req_obs[r1].end());
-  EXPECT_NE(std::find(by_req_obs[r1].begin(),
-                      by_req_obs[r1].end(),
+            by_req_obs[0].end());
+  EXPECT_NE(std::find(by_req_obs[0].begin(),
+                      by_req_obs[0].end(),
                       std::make_pair(t2, fac.mat)),
-            by_req_obs[r1].end());
-  EXPECT_NE(std::find(by_req_obs[r2].begin(),
-                      by_req_obs[r2].end(),
+            by_req_obs[0].end());
+  EXPECT_NE(std::find(by_req_obs[1].begin(),
+                      by_req_obs[1].end(),
                       std::make_pair(t3, fac.mat)),
-            by_req_obs[r2].end());
+            by_req_obs[1].end());
 
-  std::map<std::pair<Trader*, Trader*>,
-           std::vector< std::pair<Trade<Material>, Material::Ptr> > >
-      all_t_obs = exec.trade_ctx().all_trades;
-  EXPECT_NE(std::find(all_t_obs[std::make_pair(s1, r1)].begin(),
-                      all_t_obs[std::make_pair(s1, r1)].end(),
+  std::vector< std::vector< std::pair<Trade<Material>, Material::Ptr> > >
+      resp_obs = exec.trade_ctx().responses;
+  ASSERT_EQ(2, resp_obs.size());
+  EXPECT_NE(std::find(resp_obs[0].begin(),
+                      resp_obs[0].end(),
                       std::make_pair(t1, fac.mat)),
-            all_t_obs[std::make_pair(s1, r1)].end());
-  EXPECT_NE(std::find(all_t_obs[std::make_pair(s2, r1)].begin(),
-                      all_t_obs[std::make_pair(s2, r1)].end(),
+            resp_obs[0].end());
+  EXPECT_NE(std::find(resp_obs[1].begin(),
+                      resp_obs[1].end(),
                       std::make_pair(t2, fac.mat)),
-            all_t_obs[std::make_pair(s2, r1)].end());
-  EXPECT_NE(std::find(all_t_obs[std::make_pair(s2, r2)].begin(),
-                      all_t_obs[std::make_pair(s2, r2)].end(),
+            resp_obs[1].end());
+  EXPECT_NE(std::find(resp_obs[1].begin(),
+                      resp_obs[1].end(),
                       std::make_pair(t3, fac.mat)),
-            all_t_obs[std::make_pair(s2, r2)].end());
+            resp_obs[1].end());
 }
 
 // - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -